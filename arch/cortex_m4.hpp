@@ -15,11 +15,122 @@
 #define MOS_DISABLE_IRQ()         __disable_irq()
 #define MOS_ENABLE_IRQ()          __enable_irq()
 #define MOS_NOP()                 asm volatile("nop")
+#define MOS_DMB()                 __DMB()
 #define MOS_DSB()                 __DSB()
 #define MOS_ISB()                 __ISB()
 #define MOS_WFI()                 __WFI()
 
-#if (MOS_CONF_USE_HARD_FPU == true)
+// Multi-core Hooks
+// Parts of this port are single-core, a dual-core port should define these in advance:
+// - `MOS_CORE_ID()` returns the index of the current core from 0.
+// - `MOS_TRIGGER_IPI(core)` interrupts another core and `MOS_IPI_HANDLER` is its vector.
+// - `ARCH_CORE_ID_ASM` loads the core index into r0 and clobbers nothing else.
+#ifndef MOS_CORE_ID
+#define MOS_CORE_ID()             0U
+#endif
+#ifndef MOS_TRIGGER_IPI
+#define MOS_TRIGGER_IPI(core)     ((void) (core))
+#endif
+#ifndef MOS_IPI_CLEAR
+#define MOS_IPI_CLEAR()           ((void) 0)
+#endif
+#ifndef ARCH_CORE_ID_ASM
+#define ARCH_CORE_ID_ASM          "mov     r0, #0\n"
+#endif
+
+// Exclusive-monitor based try lock on a word, 0 for unlocked
+#define MOS_SPIN_TRY_LOCK(lock)   (__LDREXW(lock) == 0 ? __STREXW(1, lock) == 0 : (__CLREX(), false))
+
+// r3 = &cur_tcb[core]
+#if (MOS_CONF_CORE_NUM > 1)
+#define ARCH_CUR_TCB_ADDR_ASM     "ldr     r3, =cur_tcb\n" ARCH_CORE_ID_ASM "add     r3, r3, r0, lsl #2\n"
+#else
+#define ARCH_CUR_TCB_ADDR_ASM     "ldr     r3, =cur_tcb\n"
+#endif
+
+// SysTick Reprogramming for Tickless Idle
+// Write CTRL directly to stop/start, since a read-modify-write would clear COUNTFLAG.
+#define MOS_SYSTICK_CYCLES()      (SystemCoreClock / MOS_CONF_SYSTICK)
+#define MOS_SYSTICK_MAX_LOAD      SysTick_LOAD_RELOAD_Msk
+#define MOS_SYSTICK_STOP()        SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk
+#define MOS_SYSTICK_START()       SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk
+#define MOS_SYSTICK_GET_VAL()     SysTick->VAL
+#define MOS_SYSTICK_SET_LOAD(x)   SysTick->LOAD = (x)
+#define MOS_SYSTICK_CLR_VAL()     SysTick->VAL = 0
+#define MOS_SYSTICK_COUNTED()     ((SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk) != 0)
+#define MOS_SYSTICK_PENDING()     ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0)
+
+#if (MOS_CONF_TRACE == true) || (MOS_CONF_IRQ_PROF == true) || (MOS_CONF_BENCH == true)
+// DWT Cycle Counter for Profiling, counted per core and wraps around every 2^32 cycles
+// It's not cleared when enabled, since only differences of readings are used.
+#define MOS_CYCLES_FREQ()         SystemCoreClock
+#define MOS_CYCLES()              DWT->CYCCNT
+#define MOS_CYCLES_INIT()                                                   \
+	do {                                                                    \
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;                     \
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;                                \
+	} while (0)
+#endif
+
+#if (MOS_CONF_STACK_GUARD == true)
+// MPU Stack Guard
+// - The default memory map stays as the background of privileged accesses (PRIVDEFENA).
+// - The guard region is no-access and never executable, only its base moves on switching.
+#define MOS_MEM_FAULT_HANDLER     MemManage_Handler
+#define MOS_MPU_GUARD_REGION      7U
+#define MOS_MPU_INIT(base, size)                                                              \
+	do {                                                                                      \
+		MPU->RNR  = MOS_MPU_GUARD_REGION;                                                     \
+		MPU->RBAR = (base);                                                                   \
+		MPU->RASR = MPU_RASR_XN_Msk |                                                         \
+		            ((__builtin_ctz(size) - 1) << MPU_RASR_SIZE_Pos) | MPU_RASR_ENABLE_Msk;   \
+		MPU->CTRL = MPU_CTRL_PRIVDEFENA_Msk | MPU_CTRL_ENABLE_Msk;                            \
+		SCB->SHCSR |= SCB_SHCSR_MEMFAULTENA_Msk;                                              \
+		__DSB();                                                                              \
+		__ISB();                                                                              \
+	} while (0)
+#define MOS_MPU_GUARD(base)                                                                   \
+	do {                                                                                      \
+		MPU->RBAR = (base) | MPU_RBAR_VALID_Msk | MOS_MPU_GUARD_REGION;                       \
+		__DSB();                                                                              \
+		__ISB();                                                                              \
+	} while (0)
+#define MOS_FAULT_FROM_THREAD()   ((SCB->ICSR & SCB_ICSR_RETTOBASE_Msk) != 0)
+#define MOS_MPU_STACKING_FAULT()  ((SCB->CFSR & (SCB_CFSR_MSTKERR_Msk | SCB_CFSR_MLSPERR_Msk)) != 0)
+#define MOS_MPU_FAULT_ADDR()      ((SCB->CFSR & SCB_CFSR_MMARVALID_Msk) ? SCB->MMFAR : 0U)
+#define MOS_MPU_CLR_FAULT()       SCB->CFSR = SCB_CFSR_MEMFAULTSR_Msk
+#define MOS_SET_PSP(psp)          __set_PSP(psp)
+#endif
+
+#if (MOS_CONF_USE_HARD_FPU == true) && (MOS_CONF_LAZY_FPU == true)
+// Lazy FPU Ownership Switching
+// - Automatic FP stacking is off, so every exception frame is a basic one.
+// - CP10/CP11 are disabled for non-owners, their first FP instruction traps into UsageFault(NOCP).
+#define MOS_USAGE_FAULT_HANDLER   UsageFault_Handler
+#define MOS_FPU_ENABLE()          SCB->CPACR |= (0xFU << 20)
+#define MOS_FPU_DISABLE()         SCB->CPACR &= ~(0xFU << 20)
+#define MOS_FPU_TRAPPED()         ((SCB->CFSR & SCB_CFSR_NOCP_Msk) != 0)
+#define MOS_FPU_CLR_TRAP()        SCB->CFSR = SCB_CFSR_NOCP_Msk
+#define MOS_USAGE_FAULT_ENABLE()  SCB->SHCSR |= SCB_SHCSR_USGFAULTENA_Msk
+#define MOS_FPU_NO_AUTO_STACK()                                             \
+	do {                                                                    \
+		FPU->FPCCR &= ~(FPU_FPCCR_ASPEN_Msk | FPU_FPCCR_LSPEN_Msk);         \
+		__set_CONTROL(__get_CONTROL() & ~CONTROL_FPCA_Msk);                 \
+	} while (0)
+
+// Save/Restore S0-S31 and FPSCR, %0 = context buffer of 33 words
+#define ARCH_FPU_SAVE_ASM        \
+	"vstmia  %0, {s0-s31}\n"     \
+	"vmrs    r1, fpscr\n"        \
+	"str     r1, [%0, #128]\n"
+
+#define ARCH_FPU_LOAD_ASM        \
+	"vldmia  %0, {s0-s31}\n"     \
+	"ldr     r1, [%0, #128]\n"   \
+	"vmsr    fpscr, r1\n"
+#endif
+
+#if (MOS_CONF_USE_HARD_FPU == true) && (MOS_CONF_LAZY_FPU != true)
 // --------------------------------------------------------------------------
 // Start the first task (SVC Handler)
 // Features:
@@ -28,7 +139,7 @@
 // --------------------------------------------------------------------------
 #define ARCH_INIT_ASM                                                                \
 	"cpsid   i\n" /* Disable interrupts */                                           \
-	"ldr     r3, =cur_tcb\n"                                                         \
+	ARCH_CUR_TCB_ADDR_ASM                                                            \
 	"ldr     r1, [r3]\n"                                                             \
 	"ldr     r0, [r1,#8]\n"       /* r0 = cur_tcb.sp */                              \
 	"ldmia   r0!, {r4-r11, lr}\n" /* Pop core registers R4-R11 and EXC_RETURN(LR) */ \
@@ -43,38 +154,44 @@
 // --------------------------------------------------------------------------
 // Context Switch (PendSV Handler)
 // Features:
+// - Select next TCB first, return early if it's still the same task.
 // - Check if current task uses FPU; if so, save S16-S31.
 // - Save LR (EXC_RETURN) to stack to preserve FPU state.
 // - Restore new task's LR and conditionally restore FPU context.
+// Calling `next_tcb` first is safe since R4-R11 and S16-S31 are callee-saved.
 // --------------------------------------------------------------------------
 #define ARCH_CONTEXT_SWITCH_ASM                                             \
 	"cpsid   i\n" /* Disable interrupts */                                  \
+	ARCH_CUR_TCB_ADDR_ASM                                                   \
+	"ldr     r2, [r3]\n" /* r2 = cur_tcb (old) */                           \
+	"stmdb   sp!, {r2,r3,r12,lr}\n"                                         \
+	"bl      next_tcb\n" /* Select next TCB */                              \
+	"ldmia   sp!, {r2,r3,r12,lr}\n"                                         \
+	"ldr     r1, [r3]\n" /* r1 = cur_tcb (new) */                           \
+	"cmp     r1, r2\n"                                                      \
+	"beq     1f\n" /* Same task, skip register swapping */                  \
 	"mrs     r0, psp\n"                                                     \
 	"tst     lr, #0x10\n" /* Test Bit 4 of LR */                            \
 	"it      eq\n"                                                          \
 	"vstmdbeq r0!, {s16-s31}\n" /* If FPU used, save high vfp registers */  \
-	"ldr     r3, =cur_tcb\n"                                                \
-	"ldr     r2, [r3]\n"                                                    \
 	"stmdb   r0!, {r4-r11, lr}\n" /* Save core registers R4-R11 and LR */   \
-	"str     r0, [r2,#8]\n"       /* Update cur_tcb.sp */                   \
-	"stmdb   sp!, {r3,lr}\n"                                                \
-	"bl      next_tcb\n" /* Select next TCB */                              \
-	"ldmia   sp!, {r3,lr}\n"                                                \
-	"ldr     r1, [r3]\n"                                                    \
+	"str     r0, [r2,#8]\n"       /* Update cur_tcb.sp (old) */             \
 	"ldr     r0, [r1,#8]\n"       /* Get cur_tcb.sp (new) */                \
 	"ldmia   r0!, {r4-r11, lr}\n" /* Pop core registers R4-R11 and LR */    \
 	"tst     lr, #0x10\n"         /* Test restored LR Bit 4 */              \
 	"it      eq\n"                                                          \
 	"vldmiaeq r0!, {s16-s31}\n" /* If new task uses FPU, restore S16-S31 */ \
 	"msr     psp, r0\n"                                                     \
+	"1:\n"                                                                  \
 	"cpsie   i\n" /* Enable interrupts */                                   \
 	"bx      lr\n"
 #else
+// Without FPU, or with lazy FPU that every frame is a basic one.
 
 // From FreeRTOS -> https://www.freertos.org
 #define ARCH_INIT_ASM                                                        \
 	"cpsid   i\n" /* Disable interrupts */                                   \
-	"ldr     r3, =cur_tcb\n"                                                 \
+	ARCH_CUR_TCB_ADDR_ASM                                                    \
 	"ldr     r1, [r3]\n"                                                     \
 	"ldr     r0, [r1,#8]\n"   /* r0 = cur_tcb.sp */                          \
 	"ldmia   r0!, {r4-r11}\n" /* Pop registers R4-R11(user saved context) */ \
@@ -85,21 +202,25 @@
 	"bx      lr\n"
 
 // From FreeRTOS -> https://www.freertos.org
-#define ARCH_CONTEXT_SWITCH_ASM                          \
-	"cpsid   i\n" /* Disable interrupts */               \
-	"mrs     r0, psp\n"                                  \
-	"ldr     r3, =cur_tcb\n"                             \
-	"ldr     r2, [r3]\n"                                 \
-	"stmdb   r0!, {r4-r11}\n" /* Save core registers. */ \
-	"str     r0, [r2,#8]\n"   /* Get cur_tcb.sp */       \
-	"stmdb   sp!, {r3,lr}\n"                             \
-	"bl      next_tcb\n"                                 \
-	"ldmia   sp!, {r3,lr}\n"                             \
-	"ldr     r1, [r3]\n"                                 \
-	"ldr     r0, [r1,#8]\n"   /* Get cur_tcb.sp(new) */  \
-	"ldmia   r0!, {r4-r11}\n" /* Pop core registers. */  \
-	"msr     psp, r0\n"                                  \
-	"cpsie   i\n" /* Enable interrupts */                \
+// Select next TCB first, return early if it's still the same task.
+#define ARCH_CONTEXT_SWITCH_ASM                                  \
+	"cpsid   i\n" /* Disable interrupts */                       \
+	ARCH_CUR_TCB_ADDR_ASM                                        \
+	"ldr     r2, [r3]\n" /* r2 = cur_tcb(old) */                 \
+	"stmdb   sp!, {r2,r3,r12,lr}\n"                              \
+	"bl      next_tcb\n"                                         \
+	"ldmia   sp!, {r2,r3,r12,lr}\n"                              \
+	"ldr     r1, [r3]\n" /* r1 = cur_tcb(new) */                 \
+	"cmp     r1, r2\n"                                           \
+	"beq     1f\n"           /* Same task, skip swapping */      \
+	"mrs     r0, psp\n"                                          \
+	"stmdb   r0!, {r4-r11}\n" /* Save core registers. */         \
+	"str     r0, [r2,#8]\n"   /* Update cur_tcb.sp(old) */       \
+	"ldr     r0, [r1,#8]\n"   /* Get cur_tcb.sp(new) */          \
+	"ldmia   r0!, {r4-r11}\n" /* Pop core registers. */          \
+	"msr     psp, r0\n"                                          \
+	"1:\n"                                                       \
+	"cpsie   i\n" /* Enable interrupts */                        \
 	"bx      lr\n"
 
 #endif
@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+"""Check a capture of `bench` rows against the baseline.
+
+Rows are `bench,<case>,<tasks>,<bytes>,<iters>,<min>,<avg>,<max>` in cycles, keyed by
+`case,tasks,bytes`. A row regresses if its `avg` grows over `threshold` percent,
+and a row of the baseline missing from the capture fails as well.
+"""
+
+import argparse
+import re
+import sys
+
+ROW = re.compile(r"bench,([A-Za-z_]\w*),(\d+),(\d+),(\d+),(\d+),(\d+),(\d+)")
+HEADER = "bench,case,tasks,bytes,iters,min,avg,max"
+
+
+def load(path):
+    rows = {}
+    with open(path, errors="replace") as f:
+        for line in f:
+            m = ROW.search(line)
+            if m is None:
+                continue
+            name, tasks, size, iters, lo, avg, hi = m.groups()
+            rows[(name, int(tasks), int(size))] = (int(iters), int(lo), int(avg), int(hi))
+    return rows
+
+
+def update(baseline, capture):
+    rows = load(capture)
+    if not rows:
+        sys.exit(f"no bench rows in {capture}")
+    with open(baseline, "w") as f:
+        f.write(HEADER + "\n")
+        for (name, tasks, size), vals in rows.items():
+            f.write(",".join(map(str, ("bench", name, tasks, size) + vals)) + "\n")
+    print(f"{len(rows)} rows written to {baseline}")
+
+
+def check(baseline, capture, threshold):
+    base, cur = load(baseline), load(capture)
+    if not cur:
+        sys.exit(f"no bench rows in {capture}")
+    if not base:
+        print(f"{baseline} has no rows, take a capture of a known good build with --update first")
+        return 2
+
+    fails = 0
+    print(f"{'case':<16}{'tasks':>6}{'bytes':>6}{'base':>10}{'avg':>10}{'delta':>9}")
+    for key in sorted(base.keys() | cur.keys()):
+        name, tasks, size = key
+        if key not in cur:
+            print(f"{name:<16}{tasks:>6}{size:>6}  missing")
+            fails += 1
+            continue
+        if key not in base:
+            print(f"{name:<16}{tasks:>6}{size:>6}  new, {cur[key][2]} cycles")
+            continue
+
+        old, new = base[key][2], cur[key][2]
+        delta = (new - old) * 100.0 / old if old else 0.0
+        mark = ""
+        if delta > threshold:
+            mark = "  REGRESSED"
+            fails += 1
+        print(f"{name:<16}{tasks:>6}{size:>6}{old:>10}{new:>10}{delta:>+8.1f}%{mark}")
+
+    print(f"{fails} of {len(base)} rows failed, threshold {threshold}%")
+    return 1 if fails else 0
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("baseline")
+    ap.add_argument("capture")
+    ap.add_argument("--threshold", type=float, default=10.0, help="max increase of avg in percent")
+    ap.add_argument("--update", action="store_true", help="write the capture as the new baseline")
+    args = ap.parse_args()
+
+    if args.update:
+        update(args.baseline, args.capture)
+        return 0
+    return check(args.baseline, args.capture, args.threshold)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
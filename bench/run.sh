@@ -0,0 +1,25 @@
+#!/bin/sh
+# Run the benchmarks under Renode and check them against the baseline.
+#
+# Usage: bench/run.sh <elf> [--threshold <percent>] [--update]
+#   <elf>        Firmware built with `MOS_CONF_BENCH true` and the shell on the console UART
+#   --threshold  Max increase of `avg` cycles per row, 10 by default
+#   --update     Take this capture as the new baseline instead of checking it
+#
+# `PLATFORM` and `UART` can be set to match the board of the firmware.
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+ELF=${1:?"Usage: $0 <elf> [--threshold <percent>] [--update]"}
+shift
+LOG=$HERE/../bench_output.txt
+
+rm -f "$LOG"
+renode-test "$HERE/bench.robot" \
+	--variable BIN:"$(realpath "$ELF")" \
+	--variable LOG:"$LOG" \
+	--variable PLATFORM:"${PLATFORM:-@platforms/boards/stm32f4_discovery-kit.repl}" \
+	--variable UART:"${UART:-sysbus.usart2}"
+
+python3 "$HERE/compare.py" "$@" "$HERE/baseline.csv" "$LOG"
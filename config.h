@@ -10,26 +10,55 @@
 
 // MOS Settings
 #define MOS_CONF_USE_HARD_FPU       true       // Whether to use hardware FPU
+#define MOS_CONF_LAZY_FPU           false      // Whether to switch FPU context lazily by ownership, no FPU in ISRs
 #define MOS_CONF_ASSERT             true       // Whether to use full assert
 #define MOS_CONF_PRINTF             true       // Whether to use printf
 #define MOS_CONF_LOG_TIME           true       // Whether to add timestamp on LOG
+#define MOS_CONF_LOG_ASYNC          false      // Whether kprintf/LOG push lines into a ring drained by a log task
+#define MOS_CONF_LOG_BUF_SIZE       1024       // Bytes of log ring, power of 2
+#define MOS_CONF_LOG_LINE_SIZE      128        // Max bytes of a kprintf/LOG line in async mode
+#define MOS_CONF_LOG_BINARY         false      // Whether BLOG records a format ID and raw arguments instead of text
+#define MOS_CONF_LOG_BINARY_SIZE    256        // Words of binary log ring, power of 2
 #define MOS_CONF_DEBUG_INFO         true       // Whether to use debug info
+#define MOS_CONF_TRACE              false      // Whether to count cycles per task and trace context switches
+#define MOS_CONF_TRACE_SIZE         64         // Records of context switch trace ring, power of 2
+#define MOS_CONF_IRQ_PROF           false      // Whether to profile cycles of outermost IrqGuard_t per call site
+#define MOS_CONF_IRQ_PROF_SITES     32         // Slots of profiled call sites, power of 2
+#define MOS_CONF_BENCH              false      // Whether to build microbenchmarks of kernel hot paths
+#define MOS_CONF_BENCH_ITERS        64         // Samples of each microbenchmark case
 #define MOS_CONF_TASK_MAX           16         // Max Task Number
+#define MOS_CONF_CORE_NUM           1          // Number of cores sharing the kernel (SMP), needs port hooks if > 1
+#define MOS_CONF_MUTEX_SPIN         64         // Max polls of a PiMutex_t held on another core before blocking (SMP)
 #define MOS_CONF_POOL_SIZE          16         // Size of pre-allocated page pool
+#define MOS_CONF_POOL_SMALL_SIZE    0          // Size of pre-allocated half-page pool
+#define MOS_CONF_POOL_LARGE_SIZE    0          // Size of pre-allocated double-page pool
 #define MOS_CONF_PAGE_SIZE          1024       // Default page size in BYTES
+#define MOS_CONF_STACK_GUARD        false      // Whether an MPU region guards the stack bottom of the running task
+#define MOS_CONF_STACK_GUARD_SIZE   32         // Bytes of stack guard region, power of 2 and >= 32
+#define MOS_CONF_STACK_PAINT        false      // Whether to paint stacks for peak usage
+#define MOS_CONF_HEAP_SIZE          0          // Size of built-in TLSF heap in BYTES, 0 to use newlib heap
+#define MOS_CONF_HEAP_NEW           false      // Whether to route global operator new to TLSF heap
 #define MOS_CONF_SYSTICK            1000       // SystemFrequency / 1000 = every 1ms
 #define MOS_CONF_PRI_INV            -1         // Invalid priority
 #define MOS_CONF_PRI_MAX            0          // Max priority
 #define MOS_CONF_PRI_MIN            127        // Min priority
 #define MOS_CONF_TIME_SLICE         50         // Time slice width
+#define MOS_CONF_TICKLESS           false      // Whether to suppress ticks when idle
+#define MOS_CONF_WHEEL_SIZE         64         // Slots of sleeping timer wheel, power of 2
 #define MOS_CONF_SCHED_POLICY       PreemptPri // Scheduler Policy: RoundRobin, PreemptPri
 #define MOS_CONF_SHELL_BUF_SIZE     32         // Shell I/O Buffer Size
 #define MOS_CONF_SHELL_USR_CMD_SIZE 8          // Shell User Cmds Size
 #define MOS_CONF_ASYNC_TASK_MAX     256        // Max Executor Volume
+#define MOS_CONF_ASYNC_WORKERS      1          // Number of Executor worker tasks, share the volume
+#define MOS_CONF_ASYNC_LANES        3          // Number of Executor priority lanes
+#define MOS_CONF_ASYNC_LANE_BUDGET  8          // Max tasks in a row from upper lanes while lower lanes wait
 #define MOS_CONF_ASYNC_TASK_SIZE    32         // Lambda Captured Object Bytes
-#define MOS_CONF_ASYNC_POOL_MAX     200        // Max Parallel Corountines Size
-#define MOS_CONF_ASYNC_FRAME_SIZE   64         // Coroutines Frame Size
 #define MOS_CONF_ASYNC_USE_POOL     false      // Whether to use customized pool allocator
+#define MOS_CONF_ASYNC_POOL_32      64         // Number of 32B coroutine frames
+#define MOS_CONF_ASYNC_POOL_64      96         // Number of 64B coroutine frames
+#define MOS_CONF_ASYNC_POOL_128     32         // Number of 128B coroutine frames
+#define MOS_CONF_ASYNC_POOL_256     8          // Number of 256B coroutine frames
+#define MOS_CONF_ASYNC_POOL_HEAP    true       // Whether larger frames or full classes fall back to heap
 #define MOS_CONF_USER_NAME_SIZE     8          // Size of user name
 
 #endif
\ No newline at end of file
@@ -13,6 +13,69 @@ namespace MOS::Kernel::Alloc
 
 	using enum Page_t::Policy;
 
+	// Heap allocator in bytes, O(1) by TLSF if `MOS_CONF_HEAP_SIZE > 0`
+	MOS_INLINE inline void*
+	kmalloc(size_t size)
+	{
+#if (MOS_CONF_HEAP_SIZE > 0)
+		IrqGuard_t guard;
+		return Global::heap.malloc(size);
+#else
+		return new uint8_t[size];
+#endif
+	}
+
+	MOS_INLINE inline void
+	kfree(void* ptr)
+	{
+#if (MOS_CONF_HEAP_SIZE > 0)
+		IrqGuard_t guard;
+		Global::heap.free(ptr);
+#else
+		delete[] (uint8_t*) ptr;
+#endif
+	}
+
+	// Take from the smallest size class that fits and is not full,
+	// a class found empty counts a fail and spills to the next one
+	MOS_INLINE inline PageRaw_t
+	pool_alloc(PageSize_t page_size)
+	{
+		using namespace Global;
+
+		PageRaw_t raw = nullptr;
+		if (page_size <= small_pool.page_size() && (raw = small_pool.alloc())) {
+			return raw;
+		}
+		if (page_size <= page_pool.page_size() && (raw = page_pool.alloc())) {
+			return raw;
+		}
+		if (page_size <= large_pool.page_size()) {
+			return large_pool.alloc();
+		}
+		return nullptr;
+	}
+
+	// Return to the size class which `raw` comes from
+	MOS_INLINE inline void
+	pool_free(PageRaw_t raw)
+	{
+		using namespace Global;
+
+		if (page_pool.contains(raw)) {
+			page_pool.free(raw);
+		}
+		else if (small_pool.contains(raw)) {
+			small_pool.free(raw);
+		}
+		else if (large_pool.contains(raw)) {
+			large_pool.free(raw);
+		}
+		else {
+			MOS_ASSERT(false, "Page not in pool");
+		}
+	}
+
 	// Page Allocator
 	inline PageRaw_t // -1(0xFFFFFFFF) as invalid
 	palloc(Page_t::Policy policy, PageSize_t page_size = -1)
@@ -20,33 +83,99 @@ namespace MOS::Kernel::Alloc
 		IrqGuard_t guard;
 		switch (policy) {
 			case POOL: {
-				using Global::page_pool;
-
-				// Whether a page is used or not
-				auto unused = [](PageRaw_t raw) {
-					auto ptr = (void*) raw[0]; // ptr = tcb.link.prev
-					return (ptr == nullptr) || // Uninit -> never allocated
-					       (ptr == raw);       // Deinited -> tcb.link is self-linked, used once and recycled
-				};
+				const auto size = (page_size == -1U) ? Macro::PAGE_SIZE : page_size;
+				return pool_alloc(size);
+			}
 
-				for (const auto raw: page_pool) {
-					if (unused(raw)) {
-						return raw;
-					}
-				}
+			case DYNAMIC: {
+				MOS_ASSERT(page_size != -1U, "Page Size Error");
+				return (PageRaw_t) kmalloc(page_size * sizeof(Page_t::Word_t));
+			}
 
+			default:
 				return nullptr;
+		}
+	}
+
+	// Page Deallocator, `page` should be a copy if it's stored in itself
+	inline void
+	pfree(Page_t page)
+	{
+		IrqGuard_t guard;
+		switch (page.get_policy()) {
+			case POOL: {
+				pool_free(page.get_raw());
+				break;
 			}
 
 			case DYNAMIC: {
-				MOS_ASSERT(page_size != -1U, "Page Size Error");
-				return new uint32_t[page_size];
+				kfree(page.get_raw());
+				break;
 			}
 
 			default:
-				return nullptr;
+				break;
 		}
 	}
+
+	inline void
+	print_pools()
+	{
+		using namespace Global;
+
+		auto show = [](const char* name, const auto& pool) {
+			const auto& stats = pool.get_stats();
+			kprintf(
+			    " %-6s %5d %4d/%-4d %4d %5d\n",
+			    name, pool.page_size() * sizeof(Page_t::Word_t),
+			    stats.used, pool.capacity(),
+			    stats.peak, stats.fails
+			);
+		};
+
+		IrqGuard_t guard;
+		kprintf(" %-6s %5s %9s %4s %5s\n", "class", "bytes", "used/cap", "peak", "fails");
+		show("small", small_pool);
+		show("page", page_pool);
+		show("large", large_pool);
+	}
+
+	inline void
+	print_heap()
+	{
+#if (MOS_CONF_HEAP_SIZE > 0)
+		const auto stats = [] {
+			IrqGuard_t guard;
+			return Global::heap.get_stats();
+		}();
+
+		kprintf(
+		    " heap: %d/%d bytes, peak %d, largest %d, frag %d%%, fails %d\n",
+		    stats.used, stats.total, stats.peak,
+		    stats.largest, stats.fragmentation(), stats.fails
+		);
+#else
+		kprintf(" heap: newlib\n");
+#endif
+	}
+}
+
+#if (MOS_CONF_HEAP_NEW == true)
+static_assert(MOS_CONF_HEAP_SIZE > 0, "operator new requires TLSF heap");
+
+// Replace global allocation functions, so kernel objects are served in bounded time
+void* operator new(size_t size)
+{
+	const auto ptr = MOS::Kernel::Alloc::kmalloc(size);
+	MOS_ASSERT(ptr != nullptr, "Heap exhausted");
+	return ptr;
 }
 
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* ptr) noexcept { MOS::Kernel::Alloc::kfree(ptr); }
+void operator delete[](void* ptr) noexcept { MOS::Kernel::Alloc::kfree(ptr); }
+void operator delete(void* ptr, size_t) noexcept { MOS::Kernel::Alloc::kfree(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { MOS::Kernel::Alloc::kfree(ptr); }
+#endif
+
 #endif
\ No newline at end of file
@@ -3,39 +3,11 @@
 
 // Use C++'s Coroutine STL Infrastructure
 #include <coroutine>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
 #include "task.hpp"
-
-// Import ETL Library
-#include "etl/vector.h"
-#include "etl/priority_queue.h"
-
-// Whether to use pool allocator for async
-#if (MOS_CONF_ASYNC_USE_POOL == true)
-#include "etl/pool.h"
-#endif
-
-// -------------------------- MultiMap vs Priority Queue ----------------------------
-// ┌──────────────────┬───────────────────────┬───────────────────────┬─────────────┐
-// │ Feature          │ MultiMap              │ Priority Queue        │ Winner      │
-// ├──────────────────┼───────────────────────┼───────────────────────┼─────────────┤
-// │ RAM Overhead     │ High                  │ Lowest                │             │
-// │ (Memory)         │ (Requires node ptrs)  │ (Flat array/vector)   │ PQ Better   │
-// ├──────────────────┼───────────────────────┼───────────────────────┼─────────────┤
-// │ Cache Locality   │ Poor                  │ Excellent             │             │
-// │ (If have cache)  │ (Nodes scattered)     │ (Contiguous memory)   │ PQ Better   │
-// ├──────────────────┼───────────────────────┼───────────────────────┼─────────────┤
-// │ Insertion Speed  │ Slower                │ Faster                │             │
-// │ (Performance)    │ (Tree rebalancing)    │ (Array swapping)      │ PQ Better   │
-// ├──────────────────┼───────────────────────┼───────────────────────┼─────────────┤
-// │ Stability        │ Stable                │ Unstable              │             │
-// │ (Same Timestamp) │ (Strict FIFO)         │ (Order not guaranteed)│ Mmap Better │
-// ├──────────────────┼───────────────────────┼───────────────────────┼─────────────┤
-// │ Traversal        │ Full Access           │ Top-Only              │             │
-// │ (Inspection)     │ (Can iterate all)     │ (Can only see next)   │ Mmap Better │
-// ├──────────────────┼───────────────────────┼───────────────────────┼─────────────┤
-// │ OVERALL VERDICT  │ Good                  │ BEST                  │             │
-// │ (For Scheduler)  │ (If FIFO is critical) │ (For max performance) │ PQ Better   │
-// └──────────────────┴───────────────────────┴───────────────────────┴─────────────┘
+#include "ipc.hpp"
 
 namespace MOS::Kernel::Async
 {
@@ -53,281 +25,1081 @@ namespace MOS::Kernel::Async
 	// ==========================================================
 	// Added 'noexcept' to reduce stack overhead for exception handling.
 	// Explicit memory alignment added for cross-platform stability.
+	// Operations are generated per callable type at compile time and shared in one table:
+	// - Trivially copyable callables are moved by copying only `sizeof(F)` bytes (0 if captureless).
+	// - Move-only callables have no cloner, copying them asserts.
+	// - Trivially destructible callables have no destructor call.
 	template <size_t MAX_SIZE>
 	class FixedFn_t
 	{
 	public:
 		using Invoker_t = void (*)(void*);
 		using Cloner_t  = void (*)(void* dest, const void* src);
+		using Mover_t   = void (*)(void* dest, void* src);
+		using Dtor_t    = void (*)(void*);
 		using Buffer_t  = char[MAX_SIZE];
 
-		FixedFn_t() noexcept: invoker(nullptr), cloner(nullptr) {}
+		struct Ops_t
+		{
+			Invoker_t invoke;
+			Cloner_t clone;   // nullptr if move-only
+			Mover_t move;     // nullptr if trivially copyable -> copy `size` bytes
+			Dtor_t destroy;   // nullptr if trivially destructible
+			uint32_t size;
+		};
+
+		FixedFn_t() noexcept: ops(nullptr) {}
 
 		template <typename F>
+		    requires(!std::is_same_v<F, FixedFn_t>)
 		FixedFn_t(F f) noexcept
 		{
 			static_assert(sizeof(F) <= MAX_SIZE, "Lambda too large for Async!");
+			static_assert(alignof(F) <= alignof(FixedFn_t), "Lambda over-aligned for Async!");
 			new (buffer) F(std::move(f)); // Use placement new to construct object
-			invoker = [](void* data) { (*reinterpret_cast<F*>(data))(); };
-
-			// Cloner is only generated if copying is needed; most async tasks only require move.
-			cloner = [](void* dest, const void* src) { new (dest) F(*reinterpret_cast<const F*>(src)); };
+			ops = &OpsOf<F>::table;
 		}
 
-		FixedFn_t(const FixedFn_t& other) noexcept { copy_from(other); }
-		FixedFn_t(FixedFn_t&& other) noexcept { move_from(std::move(other)); }
+		// Plain function with a context pointer, e.g. a C callback
+		FixedFn_t(void (*fn)(void*), void* ctx) noexcept
+		    : FixedFn_t([fn, ctx] { fn(ctx); }) {}
+
+		FixedFn_t(const FixedFn_t& other) noexcept: ops(nullptr) { copy_from(other); }
+		FixedFn_t(FixedFn_t&& other) noexcept: ops(nullptr) { move_from(std::move(other)); }
+
+		~FixedFn_t() { reset(); }
 
 		FixedFn_t& operator=(const FixedFn_t& other) noexcept
 		{
-			if (this != &other) copy_from(other);
+			if (this != &other) {
+				reset();
+				copy_from(other);
+			}
 			return *this;
 		}
 
 		FixedFn_t& operator=(FixedFn_t&& other) noexcept
 		{
-			if (this != &other) move_from(std::move(other));
+			if (this != &other) {
+				reset();
+				move_from(std::move(other));
+			}
 			return *this;
 		}
 
-		explicit operator bool() const { return invoker != nullptr; }
+		explicit operator bool() const { return ops != nullptr; }
 
 		void operator()()
 		{
-			if (invoker) invoker(buffer);
+			if (ops) ops->invoke(buffer);
+		}
+
+		void reset() noexcept
+		{
+			if (ops && ops->destroy) {
+				ops->destroy(buffer);
+			}
+			ops = nullptr;
 		}
 
 	private:
 		Buffer_t buffer MOS_DEFAULT_ALIGN;
-		Invoker_t invoker;
-		Cloner_t cloner;
+		const Ops_t* ops;
+
+		template <typename F>
+		struct OpsOf
+		{
+			static constexpr bool COPYABLE = std::is_copy_constructible_v<F>,
+			                      TRIVIAL  = std::is_trivially_copyable_v<F>,
+			                      NO_DTOR  = std::is_trivially_destructible_v<F>;
+
+			static void invoke(void* data) { (*reinterpret_cast<F*>(data))(); }
+
+			static void clone(void* dest, const void* src)
+			{
+				if constexpr (COPYABLE) new (dest) F(*reinterpret_cast<const F*>(src));
+			}
+
+			static void move(void* dest, void* src)
+			{
+				new (dest) F(std::move(*reinterpret_cast<F*>(src)));
+				reinterpret_cast<F*>(src)->~F();
+			}
+
+			static void destroy(void* data) { reinterpret_cast<F*>(data)->~F(); }
+
+			static constexpr Ops_t table = {
+			    invoke,
+			    COPYABLE ? clone : nullptr,
+			    TRIVIAL ? nullptr : move,
+			    NO_DTOR ? nullptr : destroy,
+			    std::is_empty_v<F> ? 0 : sizeof(F),
+			};
+		};
 
 		void copy_from(const FixedFn_t& other)
 		{
-			if (other.invoker) {
-				other.cloner(buffer, other.buffer);
-				invoker = other.invoker;
-				cloner  = other.cloner;
+			if (other.ops) {
+				if (other.ops->move == nullptr) {
+					Utils::memcpy(buffer, other.buffer, other.ops->size);
+				}
+				else {
+					MOS_ASSERT(other.ops->clone, "Copy of move-only Lambda");
+					other.ops->clone(buffer, other.buffer);
+				}
+				ops = other.ops;
+			}
+		}
+
+		void move_from(FixedFn_t&& other)
+		{
+			if (other.ops) {
+				if (other.ops->move == nullptr) {
+					// Trivially copyable, only the used bytes
+					Utils::memcpy(buffer, other.buffer, other.ops->size);
+				}
+				else {
+					other.ops->move(buffer, other.buffer);
+				}
+				ops       = other.ops;
+				other.ops = nullptr; // Already destroyed or trivial
+			}
+		}
+	};
+
+	using Lambda_t = FixedFn_t<ASYNC_TASK_SIZE>;
+
+	// ==========================================================
+	// Lane Queue
+	// ==========================================================
+	// Tasks in `N` shared slots, linked into FIFO lists by urgency:
+	// - list[0] is the deadline lane sorted by deadline, the earliest first (EDF).
+	// - list[1...LANES] are priority lanes, lane 0 is the most urgent.
+	// Upper lists are served first, but after `BUDGET` tasks in a row one task of a
+	// lower list is served, so bulk work still progresses under urgent load.
+	// Not synchronized by itself, it's always accessed under `IrqGuard_t`.
+	template <size_t N, size_t LANES, size_t BUDGET>
+	struct LaneQueue_t
+	{
+		using Idx_t  = uint16_t;
+		using Lane_t = uint8_t;
+		using Tick_t = uint32_t;
+
+		static constexpr Idx_t NIL = -1;
+
+		static_assert(N < NIL, "Too many slots");
+		static_assert(LANES >= 1, "At least one lane");
+
+		MOS_INLINE inline uint32_t
+		size() const { return len; }
+
+		MOS_INLINE inline bool
+		empty() const { return len == 0; }
+
+		MOS_INLINE inline bool
+		full() const { return len >= N; }
+
+		void push(Lambda_t&& fn, Lane_t lane)
+		{
+			MOS_ASSERT(lane < LANES, "Invalid lane");
+			const auto idx = alloc(std::move(fn));
+			link_tail(lists[lane + 1], idx);
+		}
+
+		// O(n) sorted insertion, stable for the same deadline
+		void push_before(Lambda_t&& fn, Tick_t deadline)
+		{
+			const auto idx = alloc(std::move(fn));
+			dl[idx]        = deadline;
+
+			auto& edf  = lists[0];
+			Idx_t prev = NIL, it = edf.head;
+			while (it != NIL && (int32_t) (deadline - dl[it]) >= 0) {
+				prev = it;
+				it   = next[it];
+			}
+
+			if (prev == NIL) {
+				next[idx] = edf.head;
+				edf.head  = idx;
 			}
 			else {
-				invoker = nullptr;
-				cloner  = nullptr;
+				next[idx]  = next[prev];
+				next[prev] = idx;
+			}
+			if (it == NIL) {
+				edf.tail = idx;
 			}
 		}
 
-		void move_from(FixedFn_t&& other)
+		// Used by the owner, with anti-starvation budget
+		bool pop(Lambda_t& fn)
 		{
-			if (other.invoker) {
-				// Use memcpy for POD data movement, which is faster than cloner
-				Utils::memcpy(buffer, other.buffer, MAX_SIZE);
-				invoker       = other.invoker;
-				cloner        = other.cloner;
-				other.invoker = nullptr;
-				other.cloner  = nullptr;
+			auto i = first_of(0);
+			if (i == LIST_NUM) return false;
+
+			const auto j = first_of(i + 1);
+			if (j == LIST_NUM) {
+				streak = 0; // Nothing is waiting below
+			}
+			else if (++streak > BUDGET) {
+				streak = 0;
+				i      = lower_of(i);
+			}
+
+			take_front(lists[i], fn);
+			return true;
+		}
+
+		// Used by thieves, the most urgent one without budget
+		bool steal(Lambda_t& fn)
+		{
+			const auto i = first_of(0);
+			if (i == LIST_NUM) return false;
+			take_front(lists[i], fn);
+			return true;
+		}
+
+	private:
+		static constexpr uint32_t LIST_NUM = LANES + 1;
+
+		struct List_t
+		{
+			Idx_t head = NIL, tail = NIL;
+		};
+
+		Lambda_t slots[N];
+		Idx_t next[N];
+		Tick_t dl[N]; // Deadline of slots in list[0]
+
+		List_t lists[LIST_NUM];
+		Idx_t free_head = NIL,
+		      fresh     = 0; // Slots never used, to avoid initializing the free list
+		uint32_t len = 0, streak = 0, aged = 0;
+
+		MOS_INLINE inline uint32_t
+		first_of(uint32_t from) const
+		{
+			for (auto i = from; i < LIST_NUM; i++) {
+				if (lists[i].head != NIL) return i;
+			}
+			return LIST_NUM;
+		}
+
+		// Lower lists take turns on budget exhaustion, so none of them starves
+		MOS_INLINE inline uint32_t
+		lower_of(uint32_t upper)
+		{
+			for (uint32_t k = 1; k <= LIST_NUM; k++) {
+				const auto i = (aged + k) % LIST_NUM;
+				if (i > upper && lists[i].head != NIL) {
+					return aged = i;
+				}
+			}
+			return upper;
+		}
+
+		Idx_t alloc(Lambda_t&& fn)
+		{
+			MOS_ASSERT(!full(), "Lane queue full");
+
+			Idx_t idx;
+			if (free_head != NIL) {
+				idx       = free_head;
+				free_head = next[idx];
 			}
 			else {
-				invoker = nullptr;
-				cloner  = nullptr;
+				idx = fresh++;
+			}
+
+			slots[idx] = std::move(fn);
+			next[idx]  = NIL;
+			len += 1;
+			return idx;
+		}
+
+		MOS_INLINE inline void
+		link_tail(List_t& list, Idx_t idx)
+		{
+			if (list.tail == NIL) list.head = idx;
+			else next[list.tail] = idx;
+			list.tail = idx;
+		}
+
+		void take_front(List_t& list, Lambda_t& fn)
+		{
+			const auto idx = list.head;
+			list.head      = next[idx];
+			if (list.head == NIL) {
+				list.tail = NIL;
 			}
+
+			fn        = std::move(slots[idx]);
+			next[idx] = free_head;
+			free_head = idx;
+			len -= 1;
 		}
 	};
 
-	using Lambda_t = FixedFn_t<ASYNC_TASK_SIZE>;
+	// ==========================================================
+	// Sleep Wheel
+	// ==========================================================
+	// Hashed timer wheel of sleeping tasks as `DataType::TimerWheel_t`, in `N` shared slots
+	// linked into `W` buckets by `wake_tick & (W - 1)`. A bucket is appended in order,
+	// so sleepers of the same tick wake up in FIFO order, and a wrapping tick is safe.
+	// A sleeper is cancelled in O(1) by its handle, and a stale handle is ignored by generation.
+	// Not synchronized by itself, it's always accessed under `IrqGuard_t`.
+	template <size_t N, size_t W>
+	struct SleepWheel_t
+	{
+		using Idx_t  = uint16_t;
+		using Gen_t  = uint16_t;
+		using Tick_t = uint32_t;
+
+		static constexpr Idx_t NIL   = -1;
+		static constexpr Tick_t MASK = W - 1;
+
+		static_assert(N < NIL, "Too many slots");
+		static_assert((W & (W - 1)) == 0, "Wheel size must be a power of 2");
+
+		struct Handle_t
+		{
+			Idx_t idx = NIL;
+			Gen_t gen = 0;
+
+			explicit operator bool() const { return idx != NIL; }
+		};
+
+		MOS_INLINE inline uint32_t
+		size() const { return len; }
+
+		MOS_INLINE inline bool
+		empty() const { return len == 0; }
+
+		MOS_INLINE inline bool
+		full() const { return len >= N; }
+
+		// A due one is delayed to the next processed tick
+		Handle_t add(const Tick_t now, Tick_t wake, Lambda_t&& fn)
+		{
+			MOS_ASSERT(!full(), "Sleep wheel full");
+			resync(now);
+
+			Idx_t idx;
+			if (free_head != NIL) {
+				idx       = free_head;
+				free_head = nodes[idx].next;
+			}
+			else {
+				idx = fresh++;
+			}
+
+			if (diff(wake, cursor) <= 0) {
+				wake = cursor + 1;
+			}
+
+			auto& node = nodes[idx];
+			node.task  = std::move(fn);
+			node.wake  = wake;
+			link_tail(bucket_of(wake), idx);
+			len += 1;
+			return {idx, node.gen};
+		}
+
+		// false if already woken or cancelled
+		bool cancel(Handle_t handle)
+		{
+			if (!handle || nodes[handle.idx].gen != handle.gen) {
+				return false;
+			}
+			release(handle.idx);
+			return true;
+		}
+
+		// Take the next due sleeper, false if none.
+		// Buckets are visited in tick order, and one is passed only when it has nothing due.
+		bool pop_due(const Tick_t now, Lambda_t& fn)
+		{
+			if (resync(now)) return false;
+
+			auto steps = diff(now, cursor);
+			if (steps > (int32_t) W) { // Visit all buckets at most once
+				cursor = now - W;
+				steps  = W;
+			}
+
+			for (; steps > 0; steps -= 1) {
+				const auto& bucket = buckets[(cursor + 1) & MASK];
+				for (auto idx = bucket.head; idx != NIL; idx = nodes[idx].next) {
+					if (diff(now, nodes[idx].wake) >= 0) {
+						fn = std::move(nodes[idx].task);
+						release(idx);
+						return true;
+					}
+				}
+				cursor += 1;
+			}
+			return false;
+		}
+
+		// Ticks from `now` to the earliest wake point, searched up to `limit` ticks ahead
+		Tick_t earliest(const Tick_t now, Tick_t limit) const
+		{
+			if (limit > W) limit = W;
+			for (Tick_t tk = cursor + 1; diff(tk, now) <= (int32_t) limit; tk += 1) {
+				const auto& bucket = buckets[tk & MASK];
+				for (auto idx = bucket.head; idx != NIL; idx = nodes[idx].next) {
+					const auto left = diff(nodes[idx].wake, now);
+					if (left <= diff(tk, now)) {
+						return left > 0 ? left : 0;
+					}
+				}
+			}
+			return limit;
+		}
+
+	private:
+		struct Node_t
+		{
+			Lambda_t task;
+			Tick_t wake;
+			Idx_t prev, next;
+			Gen_t gen = 0; // Bumped on release
+		};
+
+		struct List_t
+		{
+			Idx_t head = NIL, tail = NIL;
+		};
+
+		Node_t nodes[N];
+		List_t buckets[W];
+		Idx_t free_head = NIL,
+		      fresh     = 0; // Slots never used, to avoid initializing the free list
+		uint32_t len  = 0;
+		Tick_t cursor = 0; // The last tick that has been processed
+
+		MOS_INLINE static inline int32_t
+		diff(Tick_t lhs, Tick_t rhs)
+		{
+			return (int32_t) (lhs - rhs);
+		}
+
+		MOS_INLINE inline List_t&
+		bucket_of(Tick_t wake) { return buckets[wake & MASK]; }
+
+		// Nothing to step over when empty, catch up with `now` in case it's been idle for
+		// 2^31 ticks or more, after which `cursor` would look ahead of `now`
+		MOS_INLINE inline bool
+		resync(const Tick_t now)
+		{
+			if (len != 0) return false;
+			cursor = now - 1;
+			return true;
+		}
+
+		MOS_INLINE inline void
+		link_tail(List_t& list, Idx_t idx)
+		{
+			nodes[idx].prev = list.tail;
+			nodes[idx].next = NIL;
+			if (list.tail == NIL) list.head = idx;
+			else nodes[list.tail].next = idx;
+			list.tail = idx;
+		}
+
+		void release(Idx_t idx)
+		{
+			auto& node = nodes[idx];
+			auto& list = bucket_of(node.wake);
+
+			if (node.prev == NIL) list.head = node.next;
+			else nodes[node.prev].next = node.next;
+			if (node.next == NIL) list.tail = node.prev;
+			else nodes[node.next].prev = node.prev;
+
+			node.task.reset();
+			node.gen += 1;
+			node.next = free_head;
+			free_head = idx;
+			len -= 1;
+		}
+	};
+
+	// Worker task of Executor with its local queue
+	struct Worker_t
+	{
+		LaneQueue_t<
+		    ASYNC_TASK_MAX / ASYNC_WORKERS,
+		    ASYNC_LANES, ASYNC_LANE_BUDGET>
+		    queue;
+		Task::TcbPtr_t tcb = nullptr;
+		uint32_t id        = 0;
+		volatile bool parked = false; // Blocked for nothing to do
+		char name[11]      = "async/exec";
+	};
 
 	// ==========================================================
 	// Static Executor Implementation
 	// ==========================================================
-	// Fully static, uses double-buffering to avoid queue copying.
+	// Fully static, a pool of worker tasks with a local lane queue for each.
+	// A worker runs its own tasks by urgency, and steals from others when it runs out,
+	// so a long-running task only blocks its own worker.
 	struct Executor
 	{
+		using Prior_t    = Task::Prior_t;
+		using Lane_t     = uint8_t;
+		using Sleepers_t = SleepWheel_t<ASYNC_TASK_MAX, WHEEL_SIZE>;
+		using Timer_t    = Sleepers_t::Handle_t;
+
+		static constexpr uint32_t WORKERS    = ASYNC_WORKERS,
+		                          QUEUE_SIZE = ASYNC_TASK_MAX / WORKERS;
+
+		// Lanes of `post`, a smaller one is more urgent
+		static constexpr Lane_t URGENT = 0,
+		                        NORMAL = ASYNC_LANES / 2,
+		                        BULK   = ASYNC_LANES - 1;
+
+		static_assert(WORKERS >= 1 && WORKERS <= 10, "1 ~ 10 workers");
+		static_assert(QUEUE_SIZE > 0, "ASYNC_TASK_MAX < ASYNC_WORKERS");
+
 		static void get() // Run only once for init
 		{
 			static bool init_flag = false;
 			if (!init_flag) {
-				auto async_exec = [] {
+				auto async_exec = [](Worker_t* worker) {
 					while (true) {
-						if (!poll()) {
-							Task::yield(); // Yield if idle
+						if (!poll(worker->id)) {
+							park(*worker); // Block until posted or the earliest sleeper
 						}
 					}
 				};
 
-				// Create a single task for Executor
-				if (Task::create(async_exec, nullptr, (PRI_MIN / 2), "async/exec")) {
-					init_flag = true;
-				}
-				else {
-					MOS_ASSERT(false, "Async Spawn Failed!");
+				for (uint32_t id = 0; id < WORKERS; id++) {
+					auto& worker = workers[id];
+					worker.id    = id;
+					if constexpr (WORKERS > 1) { // "async/0", "async/1", ...
+						Utils::memcpy(worker.name, "async/0", sizeof("async/0"));
+						worker.name[6] += id;
+					}
+
+					// Spread workers over cores
+					worker.tcb = Task::create_on(
+					    id % CORE_NUM,
+					    async_exec, &worker,
+					    (PRI_MIN / 2), worker.name
+					);
+
+					MOS_ASSERT(worker.tcb != nullptr, "Async Spawn Failed!");
 				}
+
+				init_flag = true;
 			}
 		}
 
-		static bool poll()
+		// Run a batch of the worker `id`, or steal one if it has nothing
+		static bool poll(uint32_t id = 0)
 		{
-			clean_sleepers(); // Process the sleeping queue
+			clean_sleepers(id); // Process the sleeping queue
 
-			// Double Buffering Switch (Ping-Pong)
-			// Get the inverse index of the current write buffer (i.e., the one we will now read).
-			// Disable interrupts during the switch to prevent 'post' from writing simultaneously.
-			uint8_t read_idx;
+			uint32_t budget;
 			{
 				IrqGuard_t guard;
-				if (task_buffers[write_idx].empty()) return false; // No tasks submitted
-
-				read_idx  = write_idx;  // Prepare to read current accumulated tasks
-				write_idx = !write_idx; // Switch write index to the other (empty) buffer
+				// Tasks posted during this batch are left for the next one
+				budget = workers[id].queue.size();
 			}
 
-			// Execute tasks
-			auto& run_list = task_buffers[read_idx];
-			for (auto& task: run_list) {
-				if (task) task();
-			}
+			uint32_t cnt = 0;
+			Lambda_t task;
+			do {
+				if (!take(id, task)) break;
+				task();
+				cnt += 1;
+			} while (cnt < budget);
 
-			run_list.clear(); // Clear buffer for its next turn as the write buffer
-			return true;
+			return cnt > 0;
 		}
 
-		static void post(Lambda_t fn)
+		static void post(Lambda_t fn, Lane_t lane = NORMAL)
 		{
 			IrqGuard_t guard;
-
-			// Try to load into buffers, with Happy Path -> O(1)
-			if (!task_buffers[write_idx].full()) {
-				task_buffers[write_idx].push_back(std::move(fn));
-			}
-			else {
-				MOS_ASSERT(false, "Async Queue Full!");
+			post_from_isr(std::move(fn), lane);
+			if (Task::current() && Task::any_higher()) {
+				return Task::yield(); // A woken worker may preempt
 			}
 		}
 
-		static void add_sleeper(uint32_t ms, Lambda_t fn)
+		static void post_from_isr(Lambda_t fn, Lane_t lane = NORMAL)
+		{
+			IrqGuard_t guard;
+			const bool ok = submit([&](auto& queue) {
+				queue.push(std::move(fn), lane);
+			});
+			MOS_ASSERT(ok, "Async Queue Full!");
+		}
+
+		// Served before all lanes in order of `deadline`
+		static void post_before(Lambda_t fn, Tick_t deadline)
+		{
+			IrqGuard_t guard;
+			const bool ok = submit([&](auto& queue) {
+				queue.push_before(std::move(fn), deadline);
+			});
+			MOS_ASSERT(ok, "Async Queue Full!");
+		}
+
+		static Timer_t add_sleeper(uint32_t ms, Lambda_t fn)
 		{
 			IrqGuard_t guard;
 			if (!sleepers.full()) {
-				sleepers.push(Sleeper_t {os_ticks + ms, std::move(fn)});
+				const Tick_t now = os_ticks;
+				const auto timer = sleepers.add(now, now + ms, std::move(fn));
+				notify(workers[0]); // A parked worker sleeps until the earliest one
+				return timer;
 			}
 			else {
 				MOS_ASSERT(false, "Async Sleeper Full!");
+				return {};
 			}
 		}
 
+		// Drop a sleeper not woken yet, false if it's already woken or cancelled
+		static bool cancel_sleeper(Timer_t timer)
+		{
+			IrqGuard_t guard;
+			return sleepers.cancel(timer);
+		}
+
+		// Run a worker at another priority, e.g. one for latency-sensitive coroutines
+		static void set_pri(uint32_t id, Prior_t pri)
+		{
+			MOS_ASSERT(id < WORKERS, "Invalid worker");
+			get();
+			Task::change_pri(workers[id].tcb, pri);
+		}
+
 	private:
-		struct Sleeper_t
+		// Static members: Stored in .bss/.data segments.
+		static inline Worker_t workers[WORKERS];
+		static inline Sleepers_t sleepers;
+
+		// Index of the worker running the caller, or the next one in turn for others
+		static uint32_t self_id()
 		{
-			uint32_t wake_tick;
-			Lambda_t task;
+			static uint32_t turn = 0;
+
+			const auto cur = Task::current();
+			for (const auto& worker: workers) {
+				if (worker.tcb == cur) return worker.id;
+			}
+			return (turn++) % WORKERS;
+		}
+
+		// Load into the local queue if not full, or any other one, with Happy Path -> O(1)
+		static bool submit(auto&& push)
+		{
+			const auto id = self_id();
+			for (uint32_t i = 0; i < WORKERS; i++) {
+				auto& worker = workers[(id + i) % WORKERS];
+				if (!worker.queue.full()) {
+					push(worker.queue);
+					notify(worker);
+					return true;
+				}
+			}
+			return false;
+		}
+
+		// Wake `target` if parked, or any other parked one to steal from it
+		static void notify(Worker_t& target)
+		{
+			if (unpark(target)) return;
+			for (auto& worker: workers) {
+				if (unpark(worker)) return;
+			}
+		}
+
+		static bool unpark(Worker_t& worker)
+		{
+			const auto tcb = worker.tcb;
+			if (!worker.parked || !tcb->is_status(DataType::TCB_t::BLOCKED)) {
+				return false;
+			}
 
-			struct Compare
+			worker.parked = false;
+			if (tcb->is_sleeping()) {
+				Task::wake_raw(tcb); // Sleeping until the earliest sleeper
+			}
+			else {
+				Task::resume_raw(tcb);
+			}
+			return true;
+		}
+
+		// Used by an idle worker, instead of yield-spinning
+		static void park(Worker_t& worker)
+		{
 			{
-				bool operator()(const Sleeper_t& lhs, const Sleeper_t& rhs) const
-				{
-					return lhs.wake_tick > rhs.wake_tick;
+				IrqGuard_t guard;
+
+				// Someone has work to share
+				for (const auto& other: workers) {
+					if (!other.queue.empty()) return;
 				}
-			};
+
+				if (sleepers.empty()) {
+					Task::block_to_raw(worker.tcb);
+				}
+				else {
+					const auto ticks = sleepers.earliest(os_ticks, WHEEL_SIZE);
+					if (ticks == 0) return; // Already due
+					Task::sleep_raw(worker.tcb, ticks);
+				}
+
+				worker.parked = true;
+				Task::yield();
+			}
+
+			worker.parked = false;
+		}
+
+		// Take a task of its own, or steal the most urgent one from others
+		static bool take(uint32_t id, Lambda_t& task)
+		{
+			IrqGuard_t guard;
+			if (workers[id].queue.pop(task)) {
+				return true;
+			}
+			for (uint32_t i = 1; i < WORKERS; i++) {
+				if (workers[(id + i) % WORKERS].queue.steal(task)) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		// Move due sleepers to the queue of the polling worker one by one, so IRQs are
+		// enabled in between, and the rest spill over to the next poll if it's full.
+		static void clean_sleepers(uint32_t id)
+		{
+			auto& queue    = workers[id].queue;
+			const auto now = os_ticks;
+			while (true) {
+				IrqGuard_t guard;
+				Lambda_t task;
+				if (queue.full() || !sleepers.pop_due(now, task)) break;
+				queue.push(std::move(task), NORMAL);
+			}
+		}
+	};
+
+	// ==========================================================
+	// Public API
+	// ==========================================================
+	inline void post(Lambda_t fn, Executor::Lane_t lane = Executor::NORMAL)
+	{
+		Executor::get();
+		Executor::post(std::move(fn), lane);
+	}
+
+	// Executor must be started by `post` or others before
+	MOS_INLINE inline void
+	post_from_isr(Lambda_t fn, Executor::Lane_t lane = Executor::NORMAL)
+	{
+		Executor::post_from_isr(std::move(fn), lane);
+	}
+
+	inline void post_before(Lambda_t fn, Tick_t deadline)
+	{
+		Executor::get();
+		Executor::post_before(std::move(fn), deadline);
+	}
+
+	inline Executor::Timer_t delay_ms(const uint32_t ms, Lambda_t fn)
+	{
+		Executor::get();
+		return Executor::add_sleeper(ms, std::move(fn));
+	}
+
+	// Cancel a `delay_ms` not fired yet, false if it's already fired or cancelled
+	MOS_INLINE inline bool
+	cancel(Executor::Timer_t timer)
+	{
+		return Executor::cancel_sleeper(timer);
+	}
+
+	inline void yield(Lambda_t fn)
+	{
+		post(std::move(fn));
+	}
+
+	// ==========================================================
+	// Coroutine Infrastructure & Memory Pool
+	// ==========================================================
+
+#if (MOS_CONF_ASYNC_USE_POOL == true)
+	struct FrameStats_t
+	{
+		uint32_t used = 0, peak = 0, fails = 0; // In frames, a fail spills to the next tier
+	};
+
+	// --- Frame Class (Static Memory Pool) ---
+	// `N` blocks of `SIZE` bytes, free blocks are linked through themselves
+	template <size_t SIZE, size_t N>
+	struct FrameClass_t
+	{
+		using Stats_t = FrameStats_t;
+
+		static constexpr size_t
+		block_size() { return SIZE; }
+
+		static constexpr size_t
+		capacity() { return N; }
+
+		MOS_INLINE inline const Stats_t&
+		get_stats() const { return stats; }
+
+		MOS_INLINE inline bool
+		owns(const void* ptr) const
+		{
+			return ptr >= blocks && ptr < blocks + N;
+		}
+
+		void* alloc()
+		{
+			Block_t* block = nullptr;
+			if (free_head != nullptr) {
+				block     = free_head;
+				free_head = block->next;
+			}
+			else if (fresh < N) {
+				block = &blocks[fresh++];
+			}
+			else {
+				stats.fails += 1;
+				return nullptr;
+			}
+
+			stats.used += 1;
+			if (stats.used > stats.peak) {
+				stats.peak = stats.used;
+			}
+			return block;
+		}
+
+		void release(void* ptr)
+		{
+			const auto block = static_cast<Block_t*>(ptr);
+			block->next      = free_head;
+			free_head        = block;
+			stats.used -= 1;
+		}
+
+	private:
+		union Block_t
+		{
+			Block_t* next;
+			alignas(std::max_align_t) char data[SIZE];
 		};
 
-		// Data structure definitions
-		using TaskBuffer_t  = etl::vector<Lambda_t, ASYNC_TASK_MAX>;
-		using SleepBuffer_t = etl::priority_queue<
-		    Sleeper_t,
-		    ASYNC_TASK_MAX,
-		    etl::vector<Sleeper_t, ASYNC_TASK_MAX>,
-		    Sleeper_t::Compare>;
+		Block_t blocks[N > 0 ? N : 1];
+		Block_t* free_head = nullptr;
+		uint32_t fresh     = 0; // Blocks never used, to avoid initializing the free list
+		Stats_t stats;
+	};
 
-		// Static members: Stored in .bss/.data segments.
-		static inline TaskBuffer_t task_buffers[2]; // Double buffers: Index 0 and 1
-		static inline volatile uint8_t write_idx = 0;
-		static inline SleepBuffer_t sleepers;
+	// --- Promise Allocator ---
+	// Non-template base class to ensure all Promise_t<T> share the same pools.
+	// A frame takes the smallest class that fits and is not full, then the heap
+	// if `MOS_CONF_ASYNC_POOL_HEAP`, otherwise the coroutine call returns an
+	// invalid Future_t via `get_return_object_on_allocation_failure`.
+	struct PromiseAllocator
+	{
+		using Class32_t  = FrameClass_t<32, ASYNC_POOL_32>;
+		using Class64_t  = FrameClass_t<64, ASYNC_POOL_64>;
+		using Class128_t = FrameClass_t<128, ASYNC_POOL_128>;
+		using Class256_t = FrameClass_t<256, ASYNC_POOL_256>;
+		using Stats_t    = FrameStats_t;
+
+		static inline Class32_t class32;
+		static inline Class64_t class64;
+		static inline Class128_t class128;
+		static inline Class256_t class256;
+		static inline Stats_t heap_stats;
+
+		// Overload operator new for Coroutines, nullptr on failure
+		static void* operator new(size_t size) noexcept
+		{
+			// Protect pool access from interrupts
+			IrqGuard_t guard;
+
+			void* ptr = nullptr;
+			for_each_class([&](auto& cls) {
+				if (ptr == nullptr && size <= cls.block_size()) {
+					ptr = cls.alloc();
+				}
+			});
+
+#if (MOS_CONF_ASYNC_POOL_HEAP == true)
+			if (ptr == nullptr) {
+				ptr = Alloc::kmalloc(size);
+				if (ptr == nullptr) {
+					heap_stats.fails += 1;
+				}
+				else if (++heap_stats.used > heap_stats.peak) {
+					heap_stats.peak = heap_stats.used;
+				}
+			}
+#endif
+			return ptr;
+		}
+
+		// Overload operator delete for Coroutines
+		static void operator delete(void* ptr, size_t) noexcept
+		{
+			IrqGuard_t guard;
+			if (ptr == nullptr) return;
+
+			bool found = false;
+			for_each_class([&](auto& cls) {
+				if (!found && cls.owns(ptr)) {
+					cls.release(ptr);
+					found = true;
+				}
+			});
+
+#if (MOS_CONF_ASYNC_POOL_HEAP == true)
+			if (!found) {
+				Alloc::kfree(ptr);
+				heap_stats.used -= 1;
+			}
+#else
+			MOS_ASSERT(found, "Async: Frame not in pool");
+#endif
+		}
 
-		static void clean_sleepers()
+		static void print_stats()
 		{
 			IrqGuard_t guard;
-			const auto now = os_ticks;
-			while (!sleepers.empty()) {
-				// Access by reference to avoid copying
-				const auto& node = sleepers.top();
-				if (static_cast<int32_t>(now - node.wake_tick) >= 0) {
-					// Wake up task: move it to the current write buffer.
-					// Note: const_cast or copy is needed since priority_queue.top() is const.
-					// Move is safe here because we pop the node immediately after.
-					if (!task_buffers[write_idx].full()) {
-						task_buffers[write_idx].push_back(std::move(const_cast<Lambda_t&>(node.task)));
-					}
-					sleepers.pop();
-				}
-				else {
-					break;
-				}
-			}
+			kprintf(" %-6s %5s %9s %4s %5s\n", "frame", "bytes", "used/cap", "peak", "fails");
+			for_each_class([](const auto& cls) {
+				const auto& stats = cls.get_stats();
+				kprintf(
+				    " %-6s %5d %4d/%-4d %4d %5d\n",
+				    "pool", cls.block_size(), stats.used,
+				    cls.capacity(), stats.peak, stats.fails
+				);
+			});
+#if (MOS_CONF_ASYNC_POOL_HEAP == true)
+			kprintf(
+			    " %-6s %5s %4d/%-4s %4d %5d\n",
+			    "heap", "-", heap_stats.used, "-",
+			    heap_stats.peak, heap_stats.fails
+			);
+#endif
+		}
+
+	private:
+		// From the smallest class to the largest
+		MOS_INLINE static inline void
+		for_each_class(auto&& fn)
+		{
+			fn(class32);
+			fn(class64);
+			fn(class128);
+			fn(class256);
 		}
 	};
+#endif
+
+	template <typename T>
+	struct Future_t;
+	template <typename T>
+	struct Promise_t;
 
 	// ==========================================================
-	// Public API
+	// Cancellation
 	// ==========================================================
-	inline void post(Lambda_t fn)
+	// Token of a combinator child, placed in the frame of the child runner (root) and shared
+	// down its `co_await` chain by `Promise_t::cancel`. The awaitable where the chain suspends
+	// arms a `hook` to detach itself from its event or sleeper, so that the whole chain can be
+	// destroyed from the root without resuming. A chain already woken can't be detached, then
+	// it runs on and destroys itself at the next cancellable suspension.
+	// Always accessed under `IrqGuard_t`.
+	struct Cancel_t
 	{
-		Executor::get();
-		Executor::post(std::move(fn));
-	}
+		using Hook_t = bool (*)(Cancel_t&);
 
-	inline void delay_ms(const uint32_t ms, Lambda_t fn)
-	{
-		Executor::get();
-		Executor::add_sleeper(ms, std::move(fn));
-	}
+		CoroHandle_t<> root = nullptr;
+		Hook_t hook         = nullptr; // false if the awaitable is already woken
+		void* ctx           = nullptr;
+		Executor::Timer_t timer;       // Of a suspended `Sleep_t`
+		bool fired = false;
 
-	inline void yield(Lambda_t fn)
-	{
-		post(std::move(fn));
-	}
+		// `co_await token.bind()` in the root, never suspends
+		struct Bind_t
+		{
+			Cancel_t& token;
 
-	// ==========================================================
-	// Coroutine Infrastructure & Memory Pool
-	// ==========================================================
+			bool await_ready() const noexcept { return false; }
+			void await_resume() const noexcept {}
 
-#if (MOS_CONF_ASYNC_USE_POOL == true)
-	// --- Promise Allocator (Static Memory Pool) ---
-	// Non-template base class to ensure all Promise_t<T> share the same pool
-	struct PromiseAllocator
-	{
-		struct FrameBlock
-		{
-			alignas(std::max_align_t) char data[ASYNC_FRAME_SIZE];
+			template <typename P>
+			bool await_suspend(CoroHandle_t<P> h) noexcept
+			{
+				token.root           = h;
+				h.promise().cancel = &token;
+				return false;
+			}
 		};
 
-		// Static Pool Object
-		static inline etl::pool<FrameBlock, ASYNC_POOL_MAX> pool;
+		MOS_INLINE inline Bind_t
+		bind() { return {*this}; }
 
-		// Overload operator new for Coroutines
-		static void* operator new(size_t size)
+		MOS_INLINE inline void
+		arm(Hook_t fn, void* arg = nullptr)
 		{
-			// Protect pool access from interrupts
-			IrqGuard_t guard;
-			// If "Async: Frame > Pool Block Size" assert, increase Macro::ASYNC_FRAME_SIZE
-			if (size > ASYNC_FRAME_SIZE) {
-				MOS_ASSERT(false, "Async: Frame > Pool Block Size");
-			}
-			if (pool.full()) { // If "Async: Pool Full" assert, increase Macro::ASYNC_POOL_MAX
-				MOS_ASSERT(false, "Async: Pool Full");
-			}
-			return pool.allocate();
+			hook = fn;
+			ctx  = arg;
 		}
-		// Overload operator delete for Coroutines
-		static void operator delete(void* ptr, size_t) noexcept
+
+		MOS_INLINE inline void
+		disarm() { hook = nullptr; }
+
+		// true if the chain is destroyed
+		bool cancel()
 		{
-			IrqGuard_t guard;
-			if (ptr) {
-				pool.release(static_cast<FrameBlock*>(ptr));
+			fired = true;
+			if (hook == nullptr || !hook(*this)) {
+				return false;
 			}
+			hook = nullptr;
+			root.destroy();
+			return true;
+		}
+
+		// Used by an awaitable before suspending, true if the chain is destroyed instead
+		MOS_INLINE inline bool
+		reap()
+		{
+			if (!fired) return false;
+			root.destroy();
+			return true;
 		}
 	};
-#endif
 
-	template <typename T>
-	struct Future_t;
-	template <typename T>
-	struct Promise_t;
+	// The token of the chain that `h` belongs to, nullptr if none
+	template <typename P>
+	MOS_INLINE inline Cancel_t*
+	token_of(CoroHandle_t<P> h)
+	{
+		if constexpr (requires { h.promise().cancel; }) {
+			return h.promise().cancel;
+		}
+		else {
+			return nullptr;
+		}
+	}
 
 	template <typename T>
 	struct PromiseRet_t
@@ -361,6 +1133,11 @@ namespace MOS::Kernel::Async
 #endif
 	{
 		CoroHandle_t<> next = nullptr;
+		Cancel_t* cancel    = nullptr; // Inherited from the awaiting one
+
+		// Destroyed by the owning `Future_t` instead of resumed
+		MOS_INLINE inline bool
+		cancelled() const { return cancel != nullptr && cancel->fired; }
 
 		void unhandled_exception() noexcept {}
 		auto initial_suspend() noexcept { return std::suspend_always {}; }
@@ -370,6 +1147,14 @@ namespace MOS::Kernel::Async
 			return Future_t<T> {CoroHandle_t<Promise_t<T>>::from_promise(*this)};
 		}
 
+#if (MOS_CONF_ASYNC_USE_POOL == true)
+		// No frame, check it by `Future_t::valid()`
+		static auto get_return_object_on_allocation_failure()
+		{
+			return Future_t<T> {nullptr};
+		}
+#endif
+
 	private:
 		struct FutureFinal_t
 		{
@@ -413,19 +1198,28 @@ namespace MOS::Kernel::Async
 		~Future_t()
 		{
 			if (handle) {
-				if (handle.done()) handle.destroy();
+				if (handle.done() || handle.promise().cancelled()) handle.destroy();
 				else
 					handle.resume();
 			}
 		}
 
+		// false if the frame allocation failed
+		MOS_INLINE inline bool
+		valid() const noexcept { return handle != nullptr; }
+
 		bool await_ready() const noexcept { return false; }
 		T await_resume() noexcept { return handle.promise().get_value(); }
 
 		template <typename P>
 		auto await_suspend(CoroHandle_t<P> next) noexcept
 		{
-			handle.promise().next = next;
+			MOS_ASSERT(valid(), "Async: Frame allocation failed");
+			auto& promise = handle.promise();
+			promise.next  = next;
+			if (promise.cancel == nullptr) {
+				promise.cancel = token_of(next);
+			}
 			return handle;
 		}
 
@@ -498,6 +1292,460 @@ namespace MOS::Kernel::Async
 			delay_ms(ticks, std::move(task));
 		});
 	}
+
+	// Frameless delay, `co_await sleep(ticks)`, cancellable in combinators
+	struct Sleep_t
+	{
+		Tick_t ticks;
+
+		bool await_ready() const noexcept { return ticks == 0; }
+		void await_resume() const noexcept {}
+
+		template <typename P>
+		void await_suspend(CoroHandle_t<P> h)
+		{
+			const CoroHandle_t<> co = h;
+			const auto token        = token_of(h);
+			if (token == nullptr) {
+				delay_ms(ticks, [co] { co.resume(); });
+				return;
+			}
+
+			IrqGuard_t guard;
+			if (token->reap()) return;
+			token->timer = delay_ms(ticks, [co, token] {
+				{
+					IrqGuard_t guard;
+					token->disarm();
+				}
+				co.resume();
+			});
+			token->arm([](Cancel_t& c) {
+				return Executor::cancel_sleeper(c.timer);
+			});
+		}
+	};
+
+	MOS_INLINE inline Sleep_t
+	sleep(const Tick_t ticks) { return Sleep_t {ticks}; }
+
+	// ==========================================================
+	// ISR Event
+	// ==========================================================
+	// Bridges an interrupt (DMA done, UART RX, EXTI...) into one waiting coroutine.
+	// `signal_from_isr` queues the waiter to the URGENT lane without allocation,
+	// and a signal without any waiter is latched for the next wait.
+	// The event must outlive its waiter, and Executor must be started before.
+	struct IsrEvent_t
+	{
+		static constexpr Tick_t FOREVER = -1;
+
+		struct Awaiter_t
+		{
+			IsrEvent_t& event;
+			Tick_t timeout;
+			bool ok = false;
+
+			bool await_ready() noexcept
+			{
+				IrqGuard_t guard;
+				ok = event.take();
+				return ok || timeout == 0;
+			}
+
+			// Signaled between ready and here -> not suspended
+			template <typename P>
+			bool await_suspend(CoroHandle_t<P> h) noexcept
+			{
+				IrqGuard_t guard;
+				const auto token = token_of(h);
+				if (token && token->reap()) return true; // Not to take a signal for a cancelled chain
+				if ((ok = event.take())) return false;
+				event.attach(h, ok, timeout, token);
+				return true;
+			}
+
+			// true if signaled, false if timeout
+			bool await_resume() const noexcept { return ok; }
+		};
+
+		// `co_await event` waits forever
+		MOS_INLINE inline Awaiter_t
+		operator co_await() { return wait_for(FOREVER); }
+
+		// `co_await event.wait_for(ticks)` returns false on timeout, 0 for polling
+		MOS_INLINE inline Awaiter_t
+		wait_for(Tick_t timeout) { return Awaiter_t {*this, timeout}; }
+
+		MOS_INLINE inline bool
+		is_waited() const { return waiter != nullptr; }
+
+		void signal_from_isr()
+		{
+			IrqGuard_t guard;
+			if (!wake(true)) {
+				pending = true;
+			}
+		}
+
+		void signal()
+		{
+			IrqGuard_t guard;
+			signal_from_isr();
+			if (Task::current() && Task::any_higher()) {
+				return Task::yield(); // A woken worker may preempt
+			}
+		}
+
+		// Drop the latched signal
+		MOS_INLINE inline void
+		reset() { pending = false; }
+
+	private:
+		CoroHandle_t<> waiter = nullptr;
+		bool* result          = nullptr; // Points into the suspended awaiter
+		Cancel_t* token       = nullptr; // Of the waiter in a combinator
+		uint32_t gen          = 0;       // Bumped on every wakeup to expire stale timeouts
+		Executor::Timer_t timer;
+		volatile bool pending = false;
+
+		MOS_INLINE inline bool
+		take()
+		{
+			const bool res = pending;
+			pending        = false;
+			return res;
+		}
+
+		void attach(CoroHandle_t<> h, bool& ok, Tick_t timeout, Cancel_t* cancel)
+		{
+			MOS_ASSERT(!waiter, "IsrEvent_t has one waiter only");
+			waiter = h;
+			result = &ok;
+			token  = cancel;
+			if (token) {
+				token->arm([](Cancel_t& c) {
+					return static_cast<IsrEvent_t*>(c.ctx)->detach();
+				}, this);
+			}
+			if (timeout != FOREVER) {
+				timer = Executor::add_sleeper(timeout, [this, g = gen] {
+					IrqGuard_t guard;
+					if (g == gen) wake(false);
+				});
+			}
+		}
+
+		// Drop the waiter without resuming it, false if none
+		bool detach()
+		{
+			if (!waiter) return false;
+			if (token) token->disarm();
+			waiter = nullptr;
+			result = nullptr;
+			token  = nullptr;
+			gen += 1;
+			Executor::cancel_sleeper(timer); // Timeout may have been woken and queued
+			timer = {};
+			return true;
+		}
+
+		bool wake(bool ok)
+		{
+			if (!waiter) return false;
+			const auto h = waiter;
+			*result      = ok;
+			detach();
+			Executor::post_from_isr([h] { h.resume(); }, Executor::URGENT);
+			return true;
+		}
+	};
+
+	// ==========================================================
+	// Awaitable Message Queue
+	// ==========================================================
+	// `IPC::MsgQueue_t` that coroutines can `co_await recv_async(timeout)`,
+	// while tasks and ISRs keep using the blocking/non-blocking API as before.
+	// One coroutine receiver at a time, tasks may still block on `recv` alongside.
+	template <typename T, size_t N>
+	struct MsgQueue_t : public IPC::MsgQueue_t<T, N>
+	{
+		using Base_t    = IPC::MsgQueue_t<T, N>;
+		using RecvMsg_t = typename Base_t::RecvMsg_t;
+
+		MsgQueue_t()
+		{
+			this->on_send = [](IPC::MsgQueueImpl_t* self) {
+				static_cast<MsgQueue_t*>(self)->event.signal_from_isr();
+			};
+		}
+
+		// Status is `TimeOut` if nothing arrives within `timeout`
+		Future_t<RecvMsg_t> recv_async(Tick_t timeout = IsrEvent_t::FOREVER)
+		{
+			const auto start = os_ticks;
+			while (true) {
+				auto res = this->recv(0);
+				if (res.status == Base_t::Ok) {
+					co_return res;
+				}
+
+				// Taken by others after the signal -> wait for the rest of timeout
+				auto left = timeout;
+				if (timeout != IsrEvent_t::FOREVER) {
+					const auto used = os_ticks - start;
+					left            = used < timeout ? timeout - used : 0;
+				}
+
+				if (!co_await event.wait_for(left)) {
+					co_return this->recv(0); // Last chance
+				}
+			}
+		}
+
+	private:
+		IsrEvent_t event;
+	};
+
+	// ==========================================================
+	// Combinators
+	// ==========================================================
+	// Children run concurrently as detached coroutines, reporting to a `Join_t` in the frame
+	// of the awaiting one, and the last needed arrival queues it to the URGENT lane.
+	// A child still running when the combinator is done is cancelled by its `Cancel_t`,
+	// e.g. detached from the `IsrEvent_t`, `MsgQueue_t::recv_async` or `sleep` it waits on.
+	// Suspended on any other awaitable, it's only unlinked and finishes with the result dropped.
+
+	struct Unit_t // Result of `Future_t<void>`
+	{
+	};
+
+	template <typename T>
+	using Result_t = std::conditional_t<std::is_void_v<T>, Unit_t, T>;
+
+	template <size_t N>
+	struct Join_t
+	{
+		using Link_t = Join_t*;
+
+		static constexpr uint32_t NONE = N;
+
+		uint32_t winner = NONE; // The first arrival
+
+		// `need` arrivals to resume `parent`
+		void start(CoroHandle_t<> h, uint32_t need)
+		{
+			parent = h;
+			wanted = need;
+			left   = need + 1; // Held by the starter until all children are started
+		}
+
+		// false if all needed have arrived during starting, then not suspended
+		bool finish_start()
+		{
+			IrqGuard_t guard;
+			return --left != 0;
+		}
+
+		// Called by the child `i`, false if it's not needed any more
+		MOS_INLINE inline bool
+		wanted_by(uint32_t i) const { return arrived < wanted && links[i] != nullptr; }
+
+		void link(uint32_t i, Link_t* ref, Cancel_t* token)
+		{
+			links[i]  = ref;
+			tokens[i] = token;
+		}
+
+		void arrive(uint32_t i)
+		{
+			links[i] = nullptr;
+			if (arrived++ >= wanted) return;
+			if (winner == NONE) winner = i;
+			if (--left == 0) {
+				Executor::post_from_isr([h = parent] { h.resume(); }, Executor::URGENT);
+			}
+		}
+
+		// Cancel children still running, or detach from those can't be cancelled
+		void cancel()
+		{
+			IrqGuard_t guard;
+			for (uint32_t i = 0; i < N; i++) {
+				if (links[i] == nullptr) continue;
+				*links[i] = nullptr;
+				links[i]  = nullptr;
+				tokens[i]->cancel();
+			}
+		}
+
+	private:
+		CoroHandle_t<> parent = nullptr;
+		uint32_t wanted = 0, arrived = 0, left = 0;
+		Link_t* links[N]      = {}; // The reference in each running child, nullptr if done
+		Cancel_t* tokens[N]   = {}; // In the frame of each child
+	};
+
+	// Await `child`, and report the result into `out` if still needed
+	template <typename T, size_t N>
+	Future_t<> join_child(Future_t<T> child, Join_t<N>* join, uint32_t i, Result_t<T>* out)
+	{
+		auto self = join;
+		Cancel_t token;
+		co_await token.bind();
+		join->link(i, &self, &token);
+
+		auto work = std::move(child); // Destroyed before the token when cancelled
+		if constexpr (std::is_void_v<T>) {
+			co_await work;
+			IrqGuard_t guard;
+			if (self) self->arrive(i);
+		}
+		else {
+			auto val = co_await work;
+			IrqGuard_t guard;
+			if (self) {
+				if (self->wanted_by(i)) *out = std::move(val);
+				self->arrive(i);
+			}
+		}
+	}
+
+	// Sleep `ticks`, and report as the child `i`
+	template <size_t N>
+	Future_t<> join_timer(Tick_t ticks, Join_t<N>* join, uint32_t i)
+	{
+		auto self = join;
+		Cancel_t token;
+		co_await token.bind();
+		join->link(i, &self, &token);
+
+		co_await sleep(ticks);
+		IrqGuard_t guard;
+		if (self) self->arrive(i);
+	}
+
+	template <typename... Ts>
+	struct WhenAll_t
+	{
+		static constexpr size_t N = sizeof...(Ts);
+
+		using Results_t = std::tuple<Result_t<Ts>...>;
+
+		WhenAll_t(Future_t<Ts>&&... fs): futures(std::move(fs)...) {}
+		~WhenAll_t() { join.cancel(); }
+
+		bool await_ready() const noexcept { return N == 0; }
+
+		bool await_suspend(CoroHandle_t<> h)
+		{
+			join.start(h, N);
+			[&]<size_t... I>(std::index_sequence<I...>) {
+				(join_child(std::move(std::get<I>(futures)), &join, I, &std::get<I>(results)).detach(), ...);
+			}(std::index_sequence_for<Ts...> {});
+			return join.finish_start();
+		}
+
+		Results_t await_resume() { return std::move(results); }
+
+	private:
+		std::tuple<Future_t<Ts>...> futures;
+		Results_t results;
+		Join_t<N> join;
+	};
+
+	template <typename T>
+	struct AnyResult_t
+	{
+		uint32_t index; // Of the first one done
+		Result_t<T> value;
+	};
+
+	template <typename T, size_t N>
+	struct WhenAny_t
+	{
+		template <typename... Fs>
+		WhenAny_t(Fs&&... fs): futures {std::move(fs)...} {}
+		~WhenAny_t() { join.cancel(); }
+
+		bool await_ready() const noexcept { return false; }
+
+		bool await_suspend(CoroHandle_t<> h)
+		{
+			join.start(h, 1);
+			for (uint32_t i = 0; i < N; i++) {
+				join_child(std::move(futures[i]), &join, i, &value).detach();
+			}
+			return join.finish_start();
+		}
+
+		AnyResult_t<T> await_resume() { return {join.winner, std::move(value)}; }
+
+	private:
+		Future_t<T> futures[N];
+		Result_t<T> value;
+		Join_t<N> join;
+	};
+
+	template <typename T>
+	struct TimedResult_t
+	{
+		bool ok; // false if timeout
+		Result_t<T> value;
+	};
+
+	template <typename T>
+	struct WithTimeout_t
+	{
+		WithTimeout_t(Future_t<T>&& f, Tick_t t): future(std::move(f)), ticks(t) {}
+
+		~WithTimeout_t() { join.cancel(); }
+
+		bool await_ready() const noexcept { return false; }
+
+		bool await_suspend(CoroHandle_t<> h)
+		{
+			join.start(h, 1);
+			join_child(std::move(future), &join, WORK, &value).detach();
+			join_timer(ticks, &join, TIMER).detach();
+			return join.finish_start();
+		}
+
+		TimedResult_t<T> await_resume() { return {join.winner == WORK, std::move(value)}; }
+
+	private:
+		static constexpr uint32_t WORK = 0, TIMER = 1;
+
+		Future_t<T> future;
+		Tick_t ticks;
+		Result_t<T> value;
+		Join_t<2> join;
+	};
+
+	// `auto [a, b] = co_await when_all(read_a(), read_b())`, void results are `Unit_t`
+	template <typename... Ts>
+	MOS_INLINE inline auto
+	when_all(Future_t<Ts>&&... futures)
+	{
+		return WhenAll_t<Ts...> {std::move(futures)...};
+	}
+
+	// `co_await when_any(f0, f1, ...)` returns the index and the result of the first one done
+	template <typename T, typename... Ts>
+	MOS_INLINE inline auto
+	when_any(Future_t<T>&& first, Future_t<Ts>&&... rest)
+	{
+		static_assert((std::is_same_v<T, Ts> && ...), "when_any needs the same result type");
+		return WhenAny_t<T, 1 + sizeof...(Ts)> {std::move(first), std::move(rest)...};
+	}
+
+	// `co_await with_timeout(f, ticks)` returns `ok == false` if `f` is not done within `ticks`
+	template <typename T>
+	MOS_INLINE inline auto
+	with_timeout(Future_t<T>&& future, Tick_t ticks)
+	{
+		return WithTimeout_t<T> {std::move(future), ticks};
+	}
 }
 
 #endif
\ No newline at end of file
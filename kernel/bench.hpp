@@ -0,0 +1,302 @@
+#ifndef _MOS_BENCH_
+#define _MOS_BENCH_
+
+#include "sync.hpp"
+#include "ipc.hpp"
+#include "async.hpp"
+
+namespace MOS::Kernel::Bench
+{
+	using namespace Global;
+
+	using Cycle_t = uint32_t;
+	using Prior_t = TCB_t::Prior_t;
+	using Sema_t  = Sync::Sema_t;
+	using Mutex_t = Sync::Mutex_t<>;
+	using Page_t  = DataType::Page_t;
+
+	using enum Page_t::Policy;
+
+	// Microbenchmarks of kernel hot paths, run on target by the task calling `run`.
+	// Each case is sampled `BENCH_ITERS` times by the cycle counter with a helper task of 1 higher priority,
+	// while the ready queue is filled with 0, 1, 4, 16, 64 spinning tasks at `PRI_MIN` as far as pages allow.
+	// Results are printed as CSV rows `bench,<case>,<tasks>,<bytes>,<iters>,<min>,<avg>,<max>` in cycles,
+	// ended by `bench,done`, and checked against a baseline by the harness in "bench/".
+	constexpr uint32_t ITERS = BENCH_ITERS;
+
+	// Far longer than any round trip, only to block without timeout
+	constexpr Tick_t WAIT = 1000;
+
+	struct Stats_t
+	{
+		Cycle_t min = -1, max = 0;
+		uint64_t sum = 0;
+		uint32_t cnt = 0;
+
+		MOS_INLINE inline void
+		add(Cycle_t cycles)
+		{
+			if (cycles < min) min = cycles;
+			if (cycles > max) max = cycles;
+			sum += cycles;
+			cnt += 1;
+		}
+
+		void print(const char* name, uint32_t tasks, uint32_t bytes) const
+		{
+			const auto avg = cnt ? (uint32_t) (sum / cnt) : 0;
+			kprintf(
+			    "bench,%s,%u,%u,%u,%u,%u,%u\n",
+			    name, tasks, bytes, cnt,
+			    cnt ? min : 0, avg, max
+			);
+		}
+	};
+
+	// Shared between the caller and helpers, a case runs at a time
+	Sema_t ping {0}, pong {0}, done {0};
+	Mutex_t mtx;
+	Async::IsrEvent_t event;
+	volatile Cycle_t stamp = 0;
+	Atomic_t<uint32_t> posted = 0; // Workers may be time-sliced in between
+
+	MOS_INLINE inline Cycle_t
+	now() { return MOS_CYCLES(); }
+
+	// The helper preempts the caller once created, and exits by itself after `ITERS` rounds
+	MOS_INLINE inline bool
+	spawn(auto fn, const char* name)
+	{
+		const Prior_t pri = Task::current()->get_pri() - 1;
+		return Task::create(fn, nullptr, pri, name) != nullptr;
+	}
+
+	inline void
+	task_create(uint32_t tasks)
+	{
+		Stats_t stats;
+		for (uint32_t i = 0; i < ITERS; i++) {
+			const auto t0  = now();
+			const auto tcb = Task::create([] {}, nullptr, PRI_MIN, "bench/new");
+			const auto t1  = now();
+			if (tcb == nullptr) break;
+			Task::terminate(tcb); // Never run since it's lower
+			stats.add(t1 - t0);
+		}
+		stats.print("task_create", tasks, 0);
+	}
+
+	// `up` wakes the helper, which `up`s back and blocks again
+	inline void
+	sema_rtt(uint32_t tasks)
+	{
+		auto helper = [] {
+			for (uint32_t i = 0; i < ITERS; i++) {
+				ping.down();
+				pong.up();
+			}
+		};
+
+		Stats_t stats;
+		if (spawn(helper, "bench/sema")) {
+			for (uint32_t i = 0; i < ITERS; i++) {
+				const auto t0 = now();
+				ping.up();
+				pong.down();
+				stats.add(now() - t0);
+			}
+		}
+		stats.print("sema_rtt", tasks, 0);
+	}
+
+	// A request is echoed by the helper through another queue
+	template <size_t BYTES>
+	inline void
+	msgq_rtt(uint32_t tasks)
+	{
+		struct Msg_t
+		{
+			uint8_t raw[BYTES];
+		};
+
+		static IPC::MsgQueue_t<Msg_t, 1> req, rsp;
+
+		auto helper = [] {
+			for (uint32_t i = 0; i < ITERS; i++) {
+				const auto res = req.recv(WAIT);
+				rsp.send(res.msg, WAIT);
+			}
+		};
+
+		Stats_t stats;
+		if (spawn(helper, "bench/msgq")) {
+			Msg_t msg {};
+			for (uint32_t i = 0; i < ITERS; i++) {
+				const auto t0 = now();
+				req.send(msg, WAIT);
+				rsp.recv(WAIT);
+				stats.add(now() - t0);
+			}
+		}
+		stats.print("msgq_rtt", tasks, BYTES);
+	}
+
+	// From the unlock of the caller to the lock acquired by the blocked helper
+	inline void
+	mutex_handoff(uint32_t tasks)
+	{
+		auto helper = [] {
+			for (uint32_t i = 0; i < ITERS; i++) {
+				ping.down();
+				auto guard = mtx.lock(); // Blocked until handed over
+				stamp      = now();
+			}
+		};
+
+		Stats_t stats;
+		if (spawn(helper, "bench/mutex")) {
+			for (uint32_t i = 0; i < ITERS; i++) {
+				Cycle_t t0;
+				{
+					auto guard = mtx.lock();
+					ping.up(); // Then the helper waits for this lock
+					t0 = now();
+				}
+				stats.add(stamp - t0);
+			}
+		}
+		stats.print("mutex_handoff", tasks, 0);
+	}
+
+	// From the first `post` to the last one of a batch executed, per task posted
+	inline void
+	async_post(uint32_t tasks)
+	{
+		constexpr uint32_t BATCH = 16;
+
+		Stats_t stats;
+		for (uint32_t i = 0; i < ITERS; i++) {
+			posted        = 0;
+			const auto t0 = now();
+			for (uint32_t j = 0; j < BATCH; j++) {
+				Async::post([] {
+					if (++posted == BATCH) {
+						done.up();
+					}
+				});
+			}
+			done.down();
+			stats.add((now() - t0) / BATCH);
+		}
+		stats.print("async_post", tasks, 0);
+	}
+
+	// From `signal` to the awaiting coroutine resumed on a worker
+	inline void
+	coro_resume(uint32_t tasks)
+	{
+		auto resumer = []() -> Async::Future_t<> {
+			for (uint32_t i = 0; i < ITERS; i++) {
+				co_await event;
+				stamp = now();
+				done.up();
+			}
+		};
+
+		Stats_t stats;
+		auto future = resumer();
+		if (future.valid()) {
+			future.detach(); // Run until the first `co_await`
+			for (uint32_t i = 0; i < ITERS; i++) {
+				while (!event.is_waited()) {
+					Task::delay(1); // Not to be latched before the next `co_await`
+				}
+				const auto t0 = now();
+				event.signal();
+				done.down();
+				stats.add(stamp - t0);
+			}
+		}
+		stats.print("coro_resume", tasks, 0);
+	}
+
+	// Spinning at `PRI_MIN` along with idle, never preempt the cases
+	MOS_INLINE inline TcbPtr_t
+	add_filler()
+	{
+		if (debug_tcbs.size() >= TASK_MAX - 1) {
+			return nullptr; // Keep a slot for helpers
+		}
+
+		const auto page = Task::page_alloc(POOL, PAGE_SIZE / 2);
+		if (page.get_raw() == nullptr) {
+			return nullptr;
+		}
+
+		auto filler = [] {
+			while (true) {
+				MOS_NOP();
+			}
+		};
+
+		return Task::create(filler, nullptr, PRI_MIN, "bench/fill", page);
+	}
+
+	// Run all cases in the caller, which should be above `PRI_MAX` and below `PRI_MIN`
+	inline void
+	run()
+	{
+		const auto pri = Task::current()->get_pri();
+		if (pri <= PRI_MAX || pri >= PRI_MIN) {
+			LOG("Bench: caller priority must be in (%d, %d)", PRI_MAX, PRI_MIN);
+			return;
+		}
+
+		Async::Executor::get(); // Spawn workers before fillers take the pages
+
+		static constexpr uint32_t STAGES[] = {0, 1, 4, 16, 64};
+		static TcbPtr_t fillers[TASK_MAX];
+		uint32_t cnt = 0, last = -1;
+
+		kprintf("bench,case,tasks,bytes,iters,min,avg,max\n");
+
+		for (const auto target: STAGES) {
+			// Kept for helpers, since all the rest may be taken by fillers
+			const auto reserved = Task::page_alloc(POOL, PAGE_SIZE);
+			if (reserved.get_raw() == nullptr) {
+				LOG("Bench: no page for helpers");
+				break;
+			}
+
+			while (cnt < target) {
+				const auto tcb = add_filler();
+				if (tcb == nullptr) break;
+				fillers[cnt++] = tcb;
+			}
+
+			Alloc::pfree(reserved); // Helpers release their pages at once when exit
+
+			if (cnt == last) {
+				break; // No more fillers than the last stage
+			}
+			last = cnt;
+
+			task_create(cnt);
+			sema_rtt(cnt);
+			msgq_rtt<4>(cnt);
+			msgq_rtt<32>(cnt);
+			msgq_rtt<128>(cnt);
+			mutex_handoff(cnt);
+			async_post(cnt);
+			coro_resume(cnt);
+		}
+
+		while (cnt > 0) {
+			Task::terminate(fillers[--cnt]);
+		}
+
+		kprintf("bench,done\n");
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,188 @@
+#ifndef _MOS_BIN_LOG_
+#define _MOS_BIN_LOG_
+
+#include <type_traits>
+#include <utility>
+#include "utils.hpp"
+#include "macro.hpp"
+#include "data_type/ring.hpp"
+
+extern "C" volatile uint32_t os_ticks;
+
+namespace MOS::Kernel::BinLog
+{
+	using namespace Macro;
+	using Utils::IrqGuard_t;
+
+	// A record is `site, ticks, args...` in words, and `site` points to the static `Site_t` of a `BLOG` call.
+	// Arguments are stored by their promoted types as in varargs, so strings are kept by pointer
+	// and must outlive the dump, e.g. literals and task names.
+	using Word_t = uintptr_t;
+	using Fmt_t  = int (*)(char*, size_t, const char*, const Word_t*);
+
+	struct Site_t
+	{
+		const char* fmt;  // Format string in a section `.mos_log.*`
+		const char* tags; // Type of each argument: `i/u` 32-bit, `I/U` 64-bit, `f` double, `s` string, `p` pointer
+		Fmt_t format;     // Formatter of the arguments on target
+		uint32_t words;   // Words of arguments
+	};
+
+	// Leading a binary dump, followed by the raw words of records
+	struct Header_t
+	{
+		uint32_t magic;   // "MOSB" in little endian
+		uint32_t word;    // Bytes of a word
+		uint32_t dropped; // Records dropped since boot
+	};
+
+	static constexpr uint32_t ARGS_MAX = 8; // Max words of arguments
+
+	template <typename T, typename D = std::decay_t<T>>
+	using Promote_t = std::conditional_t<
+	    std::is_floating_point_v<D>, double,
+	    std::conditional_t<
+	        std::is_integral_v<D> && sizeof(D) < sizeof(int), int, D>>;
+
+	template <typename T>
+	static constexpr uint32_t words_of = (sizeof(T) + sizeof(Word_t) - 1) / sizeof(Word_t);
+
+	template <typename T>
+	static constexpr char tag_of()
+	{
+		static_assert(
+		    std::is_arithmetic_v<T> || std::is_pointer_v<T>,
+		    "BLOG: only numbers and pointers are recorded"
+		);
+
+		if constexpr (std::is_floating_point_v<T>) return 'f';
+		else if constexpr (std::is_pointer_v<T>) {
+			return std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>, char> ? 's' : 'p';
+		}
+		else if constexpr (sizeof(T) > sizeof(uint32_t)) return std::is_signed_v<T> ? 'I' : 'U';
+		else
+			return std::is_signed_v<T> ? 'i' : 'u';
+	}
+
+	template <typename... Ts>
+	struct Types_t
+	{
+		static constexpr uint32_t WORDS = (words_of<Ts> + ... + 0);
+		static constexpr char tags[]    = {tag_of<Ts>()..., '\0'};
+
+		static_assert(WORDS <= ARGS_MAX, "BLOG: too many arguments");
+
+		template <typename T>
+		MOS_INLINE static inline T
+		decode(const Word_t* src)
+		{
+			T val;
+			Utils::memcpy(&val, src, sizeof(T));
+			return val;
+		}
+
+		template <typename T>
+		MOS_INLINE static inline void
+		encode(Word_t* dest, const T& arg)
+		{
+			const Promote_t<T> val = arg;
+			Utils::memcpy(dest, &val, sizeof(val));
+		}
+
+		// Word offset of the `I`-th argument
+		template <size_t I>
+		static constexpr uint32_t offset_of()
+		{
+			constexpr uint32_t w[] = {words_of<Ts>..., 0};
+			uint32_t sum           = 0;
+			for (size_t i = 0; i < I; i++) sum += w[i];
+			return sum;
+		}
+
+		static int format(char* buf, size_t size, const char* fmt, const Word_t* args)
+		{
+			return [&]<size_t... I>(std::index_sequence<I...>) {
+				return snprintf_(buf, size, fmt, decode<Ts>(args + offset_of<I>())...);
+			}(std::index_sequence_for<Ts...> {});
+		}
+
+		static constexpr Site_t
+		site(const char* fmt) { return {fmt, tags, format, WORDS}; }
+	};
+
+	// Only for `decltype` in `BLOG`
+	template <typename... Ts>
+	Types_t<Promote_t<Ts>...> types(Ts&&...);
+
+	using Ring_t = DataType::SpscRing_t<Word_t, LOG_BINARY_SIZE>;
+
+	Ring_t ring;
+	volatile uint32_t dropped = 0;
+
+	// The whole record is pushed or dropped with IRQs disabled just for copying words
+	template <typename... Ts>
+	MOS_INLINE inline void
+	write(const Site_t* site, const Ts&... args)
+	{
+		using Types = Types_t<Promote_t<Ts>...>;
+
+		Word_t rec[2 + Types::WORDS];
+		rec[0] = (Word_t) site;
+		rec[1] = os_ticks;
+
+		[&]<size_t... I>(std::index_sequence<I...>) {
+			(Types::encode(rec + 2 + Types::template offset_of<I>(), args), ...);
+		}(std::index_sequence_for<Ts...> {});
+
+		IrqGuard_t guard;
+		if (Ring_t::capacity() - ring.size() < sizeof(rec) / sizeof(Word_t)) {
+			dropped += 1;
+			return;
+		}
+		ring.push_n(rec, sizeof(rec) / sizeof(Word_t));
+	}
+
+	// Pop records and write them in binary through `write(data, bytes)`, a header first
+	inline void
+	dump(auto&& write)
+	{
+		const Header_t header {
+		    .magic   = 0x424F'534D,
+		    .word    = sizeof(Word_t),
+		    .dropped = dropped,
+		};
+
+		write((const void*) &header, sizeof(header));
+
+		Word_t buf[16];
+		uint32_t n;
+		while ((n = ring.pop_n(buf, 16)) != 0) {
+			write((const void*) buf, n * sizeof(Word_t));
+		}
+	}
+
+#if (MOS_CONF_PRINTF == true)
+	// Pop and format records on target as `LOG` does
+	inline void
+	print()
+	{
+		Word_t rec[2 + ARGS_MAX];
+		char line[LOG_LINE_SIZE];
+
+		while (ring.pop_n(rec, 2) == 2) {
+			const auto site = (const Site_t*) rec[0];
+			const auto secs = (uint32_t) rec[1] / SYSTICK;
+
+			ring.pop_n(rec + 2, site->words);
+			site->format(line, sizeof(line), site->fmt, rec + 2);
+			kprintf("[%02u:%02u:%02u] %s\n", secs / 3600, secs % 3600 / 60, secs % 60, line);
+		}
+
+		if (dropped != 0) {
+			kprintf("[blog: %u dropped]\n", dropped);
+		}
+	}
+#endif
+}
+
+#endif
\ No newline at end of file
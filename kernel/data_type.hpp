@@ -7,9 +7,15 @@
 
 #include "data_type/buffer.hpp"
 #include "data_type/queue.hpp"
+#include "data_type/ring.hpp"
 #include "data_type/bitmap.hpp"
 #include "data_type/list.hpp"
 #include "data_type/page.hpp"
+#include "data_type/page_pool.hpp"
+#include "data_type/tlsf.hpp"
 #include "data_type/tcb.hpp"
+#include "data_type/ready_queue.hpp"
+#include "data_type/timer_wheel.hpp"
+#include "data_type/registry.hpp"
 
 #endif
\ No newline at end of file
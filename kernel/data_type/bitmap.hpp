@@ -53,6 +53,21 @@ namespace MOS::DataType
 			}
 			return -1; // All bits are 1
 		}
+
+		inline int32_t
+		first_one() const volatile
+		{
+			constexpr auto end = (N + 31) / 32;
+			for (size_t i = 0; i < end; ++i) {
+				// Check if any bit is 1
+				if (data[i] != 0U) {
+					// first one from left to right
+					const uint32_t bit = __builtin_clz(data[i]);
+					return i * 32 + bit;
+				}
+			}
+			return -1; // All bits are 0
+		}
 	};
 }
 
@@ -22,16 +22,6 @@ namespace MOS::DataType
 		Raw_t raw   = nullptr;
 		Size_t size = 0;
 
-		MOS_INLINE inline void
-		recycle() volatile
-		{
-			using enum Policy;
-			if (policy == DYNAMIC) {
-				delete[] raw;
-				raw = nullptr;
-			}
-		}
-
 		MOS_INLINE inline Size_t
 		get_size() const volatile { return size; }
 
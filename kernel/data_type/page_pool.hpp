@@ -0,0 +1,131 @@
+#ifndef _MOS_PAGE_POOL_
+#define _MOS_PAGE_POOL_
+
+#include "page.hpp"
+#include "bitmap.hpp"
+
+namespace MOS::DataType
+{
+	struct PoolStats_t
+	{
+		uint32_t used  = 0, // Pages in use
+		         peak  = 0, // High-water mark of `used`
+		         fails = 0; // Allocations failed since empty
+	};
+
+	// Fixed-size page pool with `N` pages of `SIZE` words.
+	// Freed pages are linked by their first word as an intrusive free list,
+	// and never-allocated pages are taken in order, both are O(1).
+	// The state of each page is tracked by `used` explicitly.
+	template <size_t N, size_t SIZE>
+	struct PagePool_t
+	{
+		using Word_t  = Page_t::Word_t;
+		using Raw_t   = Page_t::Raw_t;
+		using Pages_t = Word_t[N][SIZE];
+		using Used_t  = BitMap_t<N>;
+		using Stats_t = PoolStats_t;
+
+		MOS_INLINE static inline constexpr size_t
+		page_size() { return SIZE; }
+
+		MOS_INLINE static inline constexpr size_t
+		capacity() { return N; }
+
+		MOS_INLINE inline bool
+		full() const { return free_list == nullptr && fresh >= N; }
+
+		MOS_INLINE inline const Stats_t&
+		get_stats() const { return stats; }
+
+		MOS_INLINE inline bool
+		contains(const void* raw) const
+		{
+			return raw >= (const void*) &pages[0] &&
+			       raw < (const void*) &pages[N];
+		}
+
+		inline Raw_t
+		alloc()
+		{
+			Raw_t raw = nullptr;
+
+			if (free_list != nullptr) {
+				raw       = free_list;
+				free_list = *(Raw_t*) raw;
+			}
+			else if (fresh < N) {
+				raw = pages[fresh++];
+			}
+			else {
+				stats.fails += 1;
+				return nullptr;
+			}
+
+			used.set(index_of(raw));
+			stats.used += 1;
+			if (stats.used > stats.peak) {
+				stats.peak = stats.used;
+			}
+			return raw;
+		}
+
+		inline void
+		free(Raw_t raw)
+		{
+			const auto idx = index_of(raw);
+			MOS_ASSERT(used.test(idx), "Page double free");
+			used.reset(idx);
+			*(Raw_t*) raw = free_list; // Link by the first word
+			free_list     = raw;
+			stats.used -= 1;
+		}
+
+	private:
+		Pages_t pages MOS_DEFAULT_ALIGN;
+		Raw_t free_list = nullptr;
+		uint32_t fresh  = 0; // Index of the first never-allocated page
+		Used_t used;
+		Stats_t stats;
+
+		MOS_INLINE inline uint32_t
+		index_of(const Raw_t raw) const
+		{
+			return (raw - &pages[0][0]) / SIZE;
+		}
+	};
+
+	// An empty size class
+	template <size_t SIZE>
+	struct PagePool_t<0, SIZE>
+	{
+		using Raw_t   = Page_t::Raw_t;
+		using Stats_t = PoolStats_t;
+
+		MOS_INLINE static inline constexpr size_t
+		page_size() { return SIZE; }
+
+		MOS_INLINE static inline constexpr size_t
+		capacity() { return 0; }
+
+		MOS_INLINE inline bool
+		full() const { return true; }
+
+		MOS_INLINE inline const Stats_t&
+		get_stats() const { return stats; }
+
+		MOS_INLINE inline bool
+		contains(const void*) const { return false; }
+
+		MOS_INLINE inline Raw_t
+		alloc() { return nullptr; }
+
+		MOS_INLINE inline void
+		free(Raw_t) {}
+
+	private:
+		Stats_t stats;
+	};
+}
+
+#endif
\ No newline at end of file
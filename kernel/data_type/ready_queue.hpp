@@ -0,0 +1,128 @@
+#ifndef _MOS_READY_QUEUE_
+#define _MOS_READY_QUEUE_
+
+#include "tcb.hpp"
+#include "bitmap.hpp"
+
+namespace MOS::DataType
+{
+	// Ready queue indexed by priority, one FIFO `TcbList_t` per level.
+	// A set bit in `bits` means the level is not empty, so the highest
+	// ready priority is located by `__builtin_clz` instead of a list walk.
+	template <size_t N>
+	struct ReadyQueueImpl_t
+	{
+		using TcbPtr_t = TCB_t::TcbPtr_t;
+		using Prior_t  = TCB_t::Prior_t;
+		using Levels_t = TcbList_t[N];
+		using Bits_t   = BitMap_t<N>;
+		using Len_t    = uint32_t;
+
+		MOS_INLINE inline Len_t
+		size() const { return len; }
+
+		MOS_INLINE inline bool
+		empty() const { return size() == 0; }
+
+		// Highest ready priority, `PRI_INV` if empty
+		MOS_INLINE inline Prior_t
+		top_pri() const
+		{
+			const auto idx = bits.first_one();
+			return idx < 0 ? PRI_INV : (Prior_t) (idx + PRI_MAX);
+		}
+
+		// Head of the highest non-empty level, `nullptr` if empty
+		MOS_INLINE inline TcbPtr_t
+		top() const
+		{
+			const auto idx = bits.first_one();
+			return idx < 0 ? nullptr : levels[idx].begin();
+		}
+
+		// Whether a ready task has higher priority than `pri`
+		MOS_INLINE inline bool
+		any_higher(Prior_t pri) const
+		{
+			return !empty() && top_pri() < pri;
+		}
+
+		// Append to the tail of its level (FIFO among the same priority)
+		MOS_INLINE inline void
+		add(TcbPtr_t tcb)
+		{
+			level_of(tcb).add(tcb);
+			bits.set(index_of(tcb));
+			len += 1;
+		}
+
+		// Must be called before `tcb->set_pri()` since the level is derived from it
+		MOS_INLINE inline void
+		remove(TcbPtr_t tcb)
+		{
+			auto& level = level_of(tcb);
+			level.remove(tcb);
+			if (level.empty()) {
+				bits.reset(index_of(tcb));
+			}
+			len -= 1;
+		}
+
+		// Move to the tail of its level, used by RoundRobin in a `PriGroup`
+		MOS_INLINE inline void
+		rotate(TcbPtr_t tcb)
+		{
+			auto& level = level_of(tcb);
+			level.remove(tcb);
+			level.add(tcb);
+		}
+
+		MOS_INLINE inline void
+		send_to(TcbPtr_t tcb, TcbList_t& dest)
+		{
+			remove(tcb);
+			dest.add(tcb);
+		}
+
+		MOS_INLINE inline void
+		send_to_in_order(
+		    TcbPtr_t tcb,
+		    TcbList_t& dest,
+		    TcbCmpFn auto&& cmp
+		)
+		{
+			remove(tcb);
+			dest.insert_in_order(tcb, cmp);
+		}
+
+		// From the highest priority to the lowest
+		MOS_INLINE inline void
+		iter(TcbListIterFn auto&& fn) const
+		{
+			for (auto& level: levels) {
+				level.iter(fn);
+			}
+		}
+
+	private:
+		Levels_t levels;
+		Bits_t bits;
+		Len_t len = 0;
+
+		MOS_INLINE static inline uint32_t
+		index_of(TcbPtr_t tcb)
+		{
+			return tcb->get_pri() - PRI_MAX;
+		}
+
+		MOS_INLINE inline TcbList_t&
+		level_of(TcbPtr_t tcb)
+		{
+			return levels[index_of(tcb)];
+		}
+	};
+
+	using ReadyQueue_t = ReadyQueueImpl_t<PRI_MIN - PRI_MAX + 1>;
+}
+
+#endif
\ No newline at end of file
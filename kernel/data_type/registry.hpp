@@ -0,0 +1,170 @@
+#ifndef _MOS_REGISTRY_
+#define _MOS_REGISTRY_
+
+#include "tcb.hpp"
+
+namespace MOS::DataType
+{
+	// Registry of live tasks, kept apart from `DebugTcbs_t`.
+	// - Tids come from a two-level bitmap, the lowest free one is found by two `clz` for `N <= 1024`.
+	// - Each tcb is indexed by its tid, and iterated in tid order over the set bits only.
+	// - Names are hashed into `2N` buckets rounded up to a power of 2 by linear probing,
+	//   removed by backward shifting without tombstones. Tasks may share a name, `find` returns any one.
+	template <size_t N>
+	struct Registry_t
+	{
+		using TcbPtr_t = TCB_t::TcbPtr_t;
+		using Tid_t    = TCB_t::Tid_t;
+		using Name_t   = TCB_t::Name_t;
+		using Hash_t   = uint32_t;
+		using Len_t    = uint32_t;
+
+		static constexpr uint32_t WORDS = (N + 31) / 32;
+
+		static_assert(WORDS <= 32, "Too many tasks for a two-level bitmap");
+
+		static constexpr uint32_t BUCKETS = [] {
+			uint32_t n = 1;
+			while (n < 2 * N) n <<= 1;
+			return n;
+		}();
+
+		static constexpr uint32_t MASK = BUCKETS - 1;
+
+		// FNV-1a, evaluated at compile time for literals, e.g. `constexpr auto code = Registry_t<N>::hash("wdog")`
+		static constexpr Hash_t
+		hash(Name_t name)
+		{
+			Hash_t code = 2166136261U;
+			while (*name != '\0') {
+				code ^= (uint8_t) *name++;
+				code *= 16777619U;
+			}
+			return code;
+		}
+
+		MOS_INLINE inline Len_t
+		size() const { return len; }
+
+		// Lowest free tid, or -1 if all taken
+		MOS_INLINE inline Tid_t
+		tid_alloc()
+		{
+			const uint32_t avail = ~full & used_mask();
+			if (avail == 0) return -1;
+
+			const uint32_t i   = __builtin_clz(avail);
+			const uint32_t bit = __builtin_clz(~bits[i] & word_mask(i));
+
+			bits[i] |= 1U << (31 - bit);
+			if ((bits[i] & word_mask(i)) == word_mask(i)) {
+				full |= 1U << (31 - i);
+			}
+			return i * 32 + bit;
+		}
+
+		// Index `tcb` by its allocated tid and its name
+		MOS_INLINE inline void
+		add(TcbPtr_t tcb)
+		{
+			const Tid_t tid   = tcb->get_tid();
+			const Hash_t code = hash(tcb->get_name());
+
+			slots[tid] = tcb;
+
+			uint32_t i = code & MASK;
+			while (keys[i] != 0) {
+				i = (i + 1) & MASK;
+			}
+			keys[i]  = tid + 1;
+			codes[i] = code;
+			len += 1;
+		}
+
+		// Drop the index of `tcb` and release its tid
+		MOS_INLINE inline void
+		remove(TcbPtr_t tcb)
+		{
+			const Tid_t tid = tcb->get_tid();
+
+			uint32_t i = hash(tcb->get_name()) & MASK;
+			while (keys[i] != tid + 1) {
+				i = (i + 1) & MASK;
+			}
+
+			// Shift back the following entries whose probe path covers `i`
+			for (uint32_t j = (i + 1) & MASK; keys[j] != 0; j = (j + 1) & MASK) {
+				const uint32_t home = codes[j] & MASK;
+				if (((j - home) & MASK) >= ((j - i) & MASK)) {
+					keys[i]  = keys[j];
+					codes[i] = codes[j];
+					i        = j;
+				}
+			}
+			keys[i] = 0;
+
+			slots[tid] = nullptr;
+			bits[tid / 32] &= ~(1U << (31 - tid % 32));
+			full &= ~(1U << (31 - tid / 32));
+			len -= 1;
+		}
+
+		MOS_INLINE inline TcbPtr_t
+		find(Tid_t tid) const
+		{
+			return (tid >= 0 && (uint32_t) tid < N) ? slots[tid] : nullptr;
+		}
+
+		// With the `code` hashed in advance, strings are only compared on hash hits
+		inline TcbPtr_t
+		find(Name_t name, Hash_t code) const
+		{
+			for (uint32_t i = code & MASK; keys[i] != 0; i = (i + 1) & MASK) {
+				if (codes[i] != code) continue;
+				const auto tcb = slots[keys[i] - 1];
+				if (Utils::strcmp(tcb->get_name(), name) == 0) {
+					return tcb;
+				}
+			}
+			return nullptr;
+		}
+
+		MOS_INLINE inline TcbPtr_t
+		find(Name_t name) const { return find(name, hash(name)); }
+
+		// Visit tasks in tid order
+		MOS_INLINE inline void
+		iter(auto&& fn) const
+		    requires Invocable<decltype(fn), void, TcbPtr_t>
+		{
+			for (uint32_t i = 0; i < WORDS; i++) {
+				for (uint32_t word = bits[i]; word != 0;) {
+					const uint32_t bit = __builtin_clz(word);
+					word &= ~(1U << (31 - bit));
+					fn(slots[i * 32 + bit]);
+				}
+			}
+		}
+
+	private:
+		uint32_t bits[WORDS] = {0}; // Tids in use, MSB first as `BitMap_t`
+		uint32_t full        = 0;   // Bit `31 - i` set once `bits[i]` is full
+		Len_t len            = 0;
+
+		TcbPtr_t slots[N]     = {nullptr};
+		Tid_t keys[BUCKETS]   = {0}; // Tid + 1 in each bucket, 0 for empty
+		Hash_t codes[BUCKETS] = {0};
+
+		// Valid bits of `full` and of each word, the tail beyond `N` is never free
+		static constexpr uint32_t
+		used_mask() { return WORDS == 32 ? ~0U : ~(~0U >> WORDS); }
+
+		static constexpr uint32_t
+		word_mask(uint32_t i)
+		{
+			return (i < WORDS - 1 || N % 32 == 0) ? ~0U : ~(~0U >> (N % 32));
+		}
+	};
+}
+
+#endif
\ No newline at end of file
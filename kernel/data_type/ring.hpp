@@ -0,0 +1,210 @@
+#ifndef _MOS_RING_
+#define _MOS_RING_
+
+#include "../utils.hpp"
+
+namespace MOS::DataType
+{
+	// Lock-free ring for exactly one producer and one consumer, e.g. ISR -> Task.
+	// `head` is only written by consumer and `tail` only by producer, both are free-running
+	// counters masked on access, so `tail - head` is the length even after wraparound.
+	// A barrier orders the data access against the index publication, no IRQ is disabled.
+	template <typename T, uint32_t N>
+	class SpscRing_t
+	{
+		static_assert(N != 0 && (N & (N - 1)) == 0, "Size must be power of 2");
+		static_assert(__is_trivially_copyable(T), "Elements are copied by memcpy");
+
+		using Index_t = volatile uint32_t;
+
+		static constexpr uint32_t MASK = N - 1;
+
+		T m_data[N];
+		Index_t m_head = 0, // Next to pop
+		        m_tail = 0; // Next to push
+
+		// Copy `n` elements between `ring[pos...]` and `buf`, split at the end of ring
+		MOS_INLINE inline void
+		copy_in(uint32_t pos, const T* buf, uint32_t n)
+		{
+			const auto idx   = pos & MASK,
+			           first = (n < N - idx) ? n : N - idx;
+			Utils::memcpy(m_data + idx, buf, first * sizeof(T));
+			Utils::memcpy(m_data, buf + first, (n - first) * sizeof(T));
+		}
+
+		MOS_INLINE inline void
+		copy_out(uint32_t pos, T* buf, uint32_t n) const
+		{
+			const auto idx   = pos & MASK,
+			           first = (n < N - idx) ? n : N - idx;
+			Utils::memcpy(buf, m_data + idx, first * sizeof(T));
+			Utils::memcpy(buf + first, m_data, (n - first) * sizeof(T));
+		}
+
+	public:
+		SpscRing_t()  = default;
+		~SpscRing_t() = default;
+
+		static inline constexpr uint32_t
+		capacity() { return N; }
+
+		MOS_INLINE inline uint32_t
+		size() const { return m_tail - m_head; }
+
+		MOS_INLINE inline bool
+		empty() const { return size() == 0; }
+
+		MOS_INLINE inline bool
+		full() const { return size() == N; }
+
+		// Producer side
+		MOS_INLINE inline bool
+		push(const T& val)
+		{
+			const uint32_t tail = m_tail;
+			if (tail - m_head == N) return false;
+			MOS_DMB(); // Slot is released by consumer before reuse
+			m_data[tail & MASK] = val;
+			MOS_DMB(); // Data is visible before publishing
+			m_tail = tail + 1;
+			return true;
+		}
+
+		// Push as many as possible, return the number pushed
+		inline uint32_t
+		push_n(const T* src, uint32_t n)
+		{
+			const uint32_t tail = m_tail,
+			               room = N - (tail - m_head);
+			if (n > room) n = room;
+			if (n == 0) return 0;
+			MOS_DMB();
+			copy_in(tail, src, n);
+			MOS_DMB();
+			m_tail = tail + n;
+			return n;
+		}
+
+		// Consumer side
+		MOS_INLINE inline bool
+		pop(T& val)
+		{
+			const uint32_t head = m_head;
+			if (m_tail == head) return false;
+			MOS_DMB(); // Data is read after its publication
+			val = m_data[head & MASK];
+			MOS_DMB(); // Data is read before releasing slot
+			m_head = head + 1;
+			return true;
+		}
+
+		// Pop as many as possible, return the number popped
+		inline uint32_t
+		pop_n(T* dest, uint32_t n)
+		{
+			const uint32_t head = m_head,
+			               len  = m_tail - head;
+			if (n > len) n = len;
+			if (n == 0) return 0;
+			MOS_DMB();
+			copy_out(head, dest, n);
+			MOS_DMB();
+			m_head = head + n;
+			return n;
+		}
+
+		// Consumer side, nullptr if empty
+		MOS_INLINE inline const T*
+		peek() const
+		{
+			if (empty()) return nullptr;
+			MOS_DMB();
+			return &m_data[m_head & MASK];
+		}
+
+		// Consumer side, drop all published elements
+		MOS_INLINE inline void
+		clear() { m_head = (uint32_t) m_tail; }
+	};
+
+	// Lock-free ring for exactly one producer and any readers, e.g. a trace log.
+	// The oldest elements are overwritten when full, so the producer never waits.
+	// `m_seq` counts all pushed elements, a reader copies and then checks it again
+	// to drop the elements whose slots may have been overwritten meanwhile.
+	template <typename T, uint32_t N>
+	class SeqRing_t
+	{
+		static_assert(N != 0 && (N & (N - 1)) == 0, "Size must be power of 2");
+		static_assert(__is_trivially_copyable(T), "Elements are copied when reading");
+
+		using Seq_t = volatile uint32_t;
+
+		static constexpr uint32_t MASK = N - 1;
+
+		T m_data[N];
+		Seq_t m_seq = 0; // Next to push
+
+	public:
+		SeqRing_t()  = default;
+		~SeqRing_t() = default;
+
+		static inline constexpr uint32_t
+		capacity() { return N; }
+
+		// Number of elements ever pushed, wraps around
+		MOS_INLINE inline uint32_t
+		total() const { return m_seq; }
+
+		// Number of elements retained
+		MOS_INLINE inline uint32_t
+		size() const
+		{
+			const uint32_t seq = m_seq;
+			return seq < N ? seq : N;
+		}
+
+		// Producer side
+		MOS_INLINE inline void
+		push(const T& val)
+		{
+			const uint32_t seq = m_seq;
+			m_data[seq & MASK] = val;
+			MOS_DMB(); // Data is visible before publishing
+			m_seq = seq + 1;
+		}
+
+		// Copy up to `n` elements in order from the `pos`-th pushed one, or from the oldest retained if it's gone.
+		// `pos` is advanced past the elements tried, return the number copied valid into `dest[0...]`.
+		inline uint32_t
+		read(uint32_t& pos, T* dest, uint32_t n) const
+		{
+			const uint32_t end  = m_seq,
+			               kept = end < N ? end : N;
+			MOS_DMB(); // Data is read after its publication
+
+			if (end - pos > kept) pos = end - kept;
+			if (n > end - pos) n = end - pos;
+
+			const uint32_t begin = pos;
+			for (uint32_t i = 0; i < n; i++) {
+				dest[i] = m_data[(begin + i) & MASK];
+			}
+
+			MOS_DMB(); // Data is read before checking again
+			const uint32_t now = m_seq;
+
+			// The slot of `now` is shared with `now - N` and may be under writing
+			uint32_t lost = (now + 1 - begin > N) ? now + 1 - begin - N : 0;
+			if (lost > n) lost = n;
+			for (uint32_t i = lost; i < n; i++) {
+				dest[i - lost] = dest[i];
+			}
+
+			pos = begin + n;
+			return n - lost;
+		}
+	};
+}
+
+#endif
\ No newline at end of file
@@ -9,6 +9,8 @@ namespace MOS::DataType
 {
 	using namespace Macro;
 
+	struct PiNode_t;
+
 	// Task Control Block
 	struct MOS_PACKED TCB_t
 	{
@@ -20,11 +22,13 @@ namespace MOS::DataType
 		using Node_t        = List_t::Node_t;
 		using Tid_t         = int16_t;
 		using Prior_t       = int8_t;
+		using Core_t        = uint8_t;
 		using Tick_t        = uint32_t;
 		using Ret_t         = void;
 		using Argv_t        = void*;
 		using Fn_t          = Ret_t (*)(Argv_t);
 		using Name_t        = const char*;
+		using FpuCtx_t      = uint32_t[33]; // S0-S31, FPSCR
 
 		enum class Status : int8_t
 		{
@@ -37,6 +41,14 @@ namespace MOS::DataType
 		using enum Status;
 		using enum Page_t::Policy;
 
+		// Wake point of a task that is not sleeping
+		static constexpr Tick_t WKPT_INV = -1;
+
+#if (MOS_CONF_STACK_PAINT == true)
+		// Filled into the unused stack on creation, overwritten words mark the peak usage
+		static constexpr uint32_t STACK_PAINT = 0xA5A5'A5A5;
+#endif
+
 		// Don't change the offset of link and sp
 		Node_t link;
 		StackPtr_t sp = nullptr;
@@ -48,20 +60,39 @@ namespace MOS::DataType
 		TcbPtr_t parent = nullptr;
 
 		Tick_t time_slice = TIME_SLICE,
-		       wake_point = -1,
+		       wake_point = WKPT_INV,
 		       stamp      = -1;
 
 		Prior_t pri     = PRI_MIN,
 		        sub_pri = PRI_INV;
 
+		// The only core to schedule it on
+		Core_t core = 0;
+
 		// For events like Send/Recv/...
 		Node_t event;
 
+		// Locks with priority inheritance owned, and the one waited for
+		PiNode_t *owned   = nullptr,
+		         *waiting = nullptr;
+
+#if (MOS_CONF_TRACE == true)
+		// Cycles spent running, times switched in, and times switched out while still ready
+		uint64_t cycles   = 0;
+		uint32_t switches = 0,
+		         preempts = 0;
+#endif
+
 		// Only for debug
 		Fn_t fn     = nullptr;
 		Argv_t argv = nullptr;
 		Name_t name = "";
 
+#if (MOS_CONF_USE_HARD_FPU == true) && (MOS_CONF_LAZY_FPU == true)
+		// Saved when the FPU is handed over to another task, VSTM/VLDM need a word-aligned base
+		FpuCtx_t fpu_ctx MOS_ALIGN(4) = {0};
+#endif
+
 		TCB_t() = default;
 		TCB_t(
 		    Fn_t fn, Argv_t argv, Prior_t pri,
@@ -81,11 +112,11 @@ namespace MOS::DataType
 			return (TcbPtr_t) link.prev;
 		}
 
+		// The page is returned by `Alloc::pfree` thereafter
 		inline void
 		release() volatile
 		{
 			link.deinit();
-			page.recycle();
 		}
 
 		MOS_INLINE inline void
@@ -112,6 +143,18 @@ namespace MOS::DataType
 			return tid;
 		}
 
+		MOS_INLINE inline void
+		set_core(Core_t _core) volatile
+		{
+			core = _core;
+		}
+
+		MOS_INLINE inline Core_t
+		get_core() const volatile
+		{
+			return core;
+		}
+
 		MOS_INLINE inline void
 		set_status(Status _status) volatile
 		{
@@ -133,7 +176,7 @@ namespace MOS::DataType
 		MOS_INLINE inline bool
 		is_sleeping() const volatile
 		{
-			return wake_point != 0 && is_status(BLOCKED);
+			return wake_point != WKPT_INV && is_status(BLOCKED);
 		}
 
 		MOS_INLINE inline Name_t
@@ -174,6 +217,27 @@ namespace MOS::DataType
 			}
 		}
 
+		// The priority without any inheritance
+		MOS_INLINE inline Prior_t
+		get_base_pri() const volatile
+		{
+			return sub_pri != PRI_INV ? sub_pri : pri;
+		}
+
+		MOS_INLINE inline void // Used in PiMutex
+		inherit_pri(Prior_t eff) volatile
+		{
+			const auto base = get_base_pri();
+			if (eff < base) {
+				sub_pri = base;
+				set_pri(eff);
+			}
+			else {
+				sub_pri = PRI_INV;
+				set_pri(base);
+			}
+		}
+
 		MOS_INLINE inline void
 		set_sp(const uint32_t _sp) volatile
 		{
@@ -246,6 +310,48 @@ namespace MOS::DataType
 			return atu * 25 / (page.get_size() - sizeof(TCB_t) / sizeof(void*));
 		}
 
+		// Lowest word the stack can grow down to, above the tcb and the guard region if any
+		MOS_INLINE inline StackPtr_t
+		stack_limit() const volatile
+		{
+			const uintptr_t end = (uintptr_t) page.get_raw() + sizeof(TCB_t);
+#if (MOS_CONF_STACK_GUARD == true)
+			return (StackPtr_t) ((end + STACK_GUARD_SIZE - 1) / STACK_GUARD_SIZE * STACK_GUARD_SIZE + STACK_GUARD_SIZE);
+#else
+			return (StackPtr_t) ((end + sizeof(uint32_t) - 1) / sizeof(uint32_t) * sizeof(uint32_t));
+#endif
+		}
+
+		// Bytes from `stack_limit` to the bottom of page
+		MOS_INLINE inline uint32_t
+		stack_size() const volatile
+		{
+			return (&page.from_bottom() - stack_limit()) * sizeof(uint32_t);
+		}
+
+#if (MOS_CONF_STACK_GUARD == true)
+		// Base of the guard region right below `stack_limit`, aligned to its size
+		MOS_INLINE inline uint32_t
+		stack_guard() const volatile
+		{
+			return (uint32_t) stack_limit() - STACK_GUARD_SIZE;
+		}
+#endif
+
+#if (MOS_CONF_STACK_PAINT == true)
+		// Peak bytes of stack ever used, scanned up from `stack_limit` to the first overwritten word
+		MOS_INLINE inline uint32_t
+		stack_peak() const volatile
+		{
+			const auto top = &page.from_bottom();
+			auto it        = stack_limit();
+			while (it < top && *it == STACK_PAINT) {
+				it += 1;
+			}
+			return (top - it) * sizeof(uint32_t);
+		}
+#endif
+
 		MOS_INLINE inline bool
 		in_event() const volatile
 		{
@@ -258,10 +364,11 @@ namespace MOS::DataType
 			return lhs->get_pri() < rhs->get_pri();
 		}
 
+		// Compare by signed distance to survive the wrapping of ticks
 		MOS_INLINE static inline bool
 		wkpt_cmp(ConstTcbPtr_t lhs, ConstTcbPtr_t rhs)
 		{
-			return lhs->get_wkpt() < rhs->get_wkpt();
+			return (int32_t) (lhs->get_wkpt() - rhs->get_wkpt()) < 0;
 		}
 
 		MOS_INLINE static inline bool
@@ -287,6 +394,10 @@ namespace MOS::DataType
 		}
 	};
 
+#if (MOS_CONF_USE_HARD_FPU == true) && (MOS_CONF_LAZY_FPU == true)
+	static_assert(offsetof(TCB_t, fpu_ctx) % 4 == 0, "FPU context must be word-aligned");
+#endif
+
 	template <typename Fn, typename Ret = void>
 	concept TcbListIterFn = Invocable<Fn, Ret, const TCB_t&>;
 
@@ -396,6 +507,14 @@ namespace MOS::DataType
 		}
 	};
 
+	// A lock with priority inheritance, chained in `TCB_t::owned` of its owner
+	struct PiNode_t
+	{
+		PiNode_t* next  = nullptr; // The next lock owned by the same task
+		TCB_t* owner    = nullptr;
+		TcbList_t waiters;         // Sorted by priority
+	};
+
 	struct DebugTcbs_t
 	{
 		using TcbPtr_t = TCB_t::TcbPtr_t;
@@ -0,0 +1,113 @@
+#ifndef _MOS_TIMER_WHEEL_
+#define _MOS_TIMER_WHEEL_
+
+#include "tcb.hpp"
+
+namespace MOS::DataType
+{
+	// Hashed timer wheel of sleeping tasks, each slot is a `TcbList_t`.
+	// A task is hashed by `wake_point & (N - 1)` in O(1), and a tick only scans the slot it lands on.
+	// Tasks sleeping longer than `N` ticks stay in their slot across rounds until they are due.
+	// All comparisons are done on the signed distance, so a wrapping `os_ticks` is safe.
+	template <size_t N>
+	struct TimerWheel_t
+	{
+		static_assert((N & (N - 1)) == 0, "Wheel size must be a power of 2");
+
+		using TcbPtr_t = TCB_t::TcbPtr_t;
+		using Tick_t   = TCB_t::Tick_t;
+		using Slots_t  = TcbList_t[N];
+		using Len_t    = uint32_t;
+
+		static constexpr Tick_t MASK = N - 1;
+
+		MOS_INLINE inline Len_t
+		size() const { return len; }
+
+		MOS_INLINE inline bool
+		empty() const { return size() == 0; }
+
+		// `tcb->wake_point` must be set before, a due one is delayed to the next processed tick
+		MOS_INLINE inline void
+		add(TcbPtr_t tcb)
+		{
+			auto wkpt = tcb->get_wkpt();
+			if (diff(wkpt, cursor) <= 0) {
+				wkpt = cursor + 1;
+			}
+			if (wkpt == TCB_t::WKPT_INV) {
+				wkpt += 1; // Reserved for not sleeping
+			}
+			tcb->set_wkpt(wkpt);
+			slot_of(tcb).add(tcb);
+			len += 1;
+		}
+
+		// Must be called before `tcb->wake_point` is changed
+		MOS_INLINE inline void
+		remove(TcbPtr_t tcb)
+		{
+			slot_of(tcb).remove(tcb);
+			len -= 1;
+		}
+
+		// Process every slot passed since the last call, `fn(tcb)` must remove the expired `tcb`
+		inline void
+		expire(const Tick_t now, auto&& fn)
+		{
+			auto steps = diff(now, cursor);
+			if (steps <= 0) return;
+			if (steps > (int32_t) N) steps = N; // Visit all slots at most once
+
+			for (; steps > 0; steps -= 1) {
+				cursor += 1;
+				auto& slot = slots[cursor & MASK];
+				for (auto it = slot.begin(); it != slot.end();) {
+					const auto nx = it->next();
+					if (diff(now, it->get_wkpt()) >= 0) {
+						fn(it);
+					}
+					it = nx;
+				}
+			}
+
+			cursor = now;
+		}
+
+		// Ticks from `now` to the earliest wake point, searched up to `limit` ticks ahead
+		inline Tick_t
+		earliest(const Tick_t now, Tick_t limit) const
+		{
+			if (limit > N) limit = N;
+			for (Tick_t tk = cursor + 1; diff(tk, now) <= (int32_t) limit; tk += 1) {
+				const auto& slot = slots[tk & MASK];
+				for (auto it = slot.begin(); it != slot.end(); it = it->next()) {
+					const auto left = diff(it->get_wkpt(), now);
+					if (left <= diff(tk, now)) {
+						return left > 0 ? left : 0;
+					}
+				}
+			}
+			return limit;
+		}
+
+	private:
+		Slots_t slots;
+		Len_t len     = 0;
+		Tick_t cursor = 0; // The last tick that has been processed
+
+		MOS_INLINE static inline int32_t
+		diff(Tick_t lhs, Tick_t rhs)
+		{
+			return (int32_t) (lhs - rhs);
+		}
+
+		MOS_INLINE inline TcbList_t&
+		slot_of(TcbPtr_t tcb)
+		{
+			return slots[tcb->get_wkpt() & MASK];
+		}
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,324 @@
+#ifndef _MOS_TLSF_
+#define _MOS_TLSF_
+
+#include "../utils.hpp"
+
+namespace MOS::DataType
+{
+	// Two-Level Segregated Fit allocator over a static region of `SIZE` bytes.
+	// Free blocks are kept in lists classified by (fl, sl), where `fl` is the power of 2
+	// and `sl` splits each power linearly into `SL_COUNT` ranges. Both levels are indexed by
+	// bitmaps, so a suitable block is found with `__builtin_ctz` and malloc/free are O(1).
+	// Adjacent free blocks are merged immediately by boundary tags.
+	template <size_t SIZE>
+	struct Tlsf_t
+	{
+		using Size_t = uint32_t;
+
+		static constexpr Size_t ALIGN       = 8,
+		                        ALIGN_LOG2  = 3,
+		                        SL_LOG2     = 4,
+		                        SL_COUNT    = 1 << SL_LOG2,
+		                        FL_SHIFT    = SL_LOG2 + ALIGN_LOG2,
+		                        SMALL_BLOCK = 1 << FL_SHIFT,
+		                        FL_MAX      = 32 - __builtin_clz(SIZE),
+		                        FL_COUNT    = FL_MAX - FL_SHIFT + 1;
+
+		static_assert(SIZE >= 1024 && SIZE % ALIGN == 0, "Invalid heap size");
+		static_assert(FL_COUNT <= 32, "Heap too large");
+
+		struct Stats_t
+		{
+			Size_t total   = 0, // Bytes for payload
+			       used    = 0, // Bytes allocated
+			       peak    = 0, // High-water mark of `used`
+			       fails   = 0, // Failed allocations
+			       largest = 0; // Largest free block
+
+			// Percentage of free memory that can't serve the largest request
+			MOS_INLINE inline uint32_t
+			fragmentation() const
+			{
+				const auto free = total - used;
+				return free ? 100 - largest * 100 / free : 0;
+			}
+		};
+
+		void* malloc(Size_t size)
+		{
+			if (!ready) init();
+
+			size = adjust(size);
+			if (size == 0 || size > SIZE) {
+				stats.fails += 1;
+				return nullptr;
+			}
+
+			Size_t fl, sl;
+			mapping_search(size, fl, sl);
+
+			auto block = search_suitable(fl, sl);
+			if (block == nullptr) {
+				stats.fails += 1;
+				return nullptr;
+			}
+
+			remove_free(block, fl, sl);
+			split(block, size);
+			mark_used(block);
+
+			stats.used += block->get_size();
+			if (stats.used > stats.peak) {
+				stats.peak = stats.used;
+			}
+
+			return block->payload();
+		}
+
+		void free(void* ptr)
+		{
+			if (ptr == nullptr) return;
+
+			auto block = Block_t::from(ptr);
+			MOS_ASSERT(!block->is_free(), "Heap double free");
+			stats.used -= block->get_size();
+
+			block = merge_prev(block);
+			block = merge_next(block);
+			mark_free(block);
+			insert_free(block);
+		}
+
+		// O(n) of the largest list, only for inspection
+		Stats_t get_stats()
+		{
+			if (!ready) init();
+
+			stats.largest = 0;
+			if (fl_bitmap != 0) {
+				const Size_t fl = 31 - __builtin_clz(fl_bitmap),
+				             sl = 31 - __builtin_clz(sl_bitmap[fl]);
+				for (auto it = blocks[fl][sl]; it != nullptr; it = it->next_free) {
+					if (it->get_size() > stats.largest) {
+						stats.largest = it->get_size();
+					}
+				}
+			}
+			return stats;
+		}
+
+	private:
+		struct Block_t
+		{
+			static constexpr Size_t
+			    FREE      = 1 << 0,
+			    PREV_FREE = 1 << 1,
+			    FLAGS     = FREE | PREV_FREE;
+
+			Block_t* prev_phys; // Physically previous block
+			Size_t size;        // Payload size with flags in low bits
+
+			// Only valid in free blocks, overlap with payload
+			Block_t *next_free, *prev_free;
+
+			MOS_INLINE inline Size_t
+			get_size() const { return size & ~FLAGS; }
+
+			MOS_INLINE inline void
+			set_size(Size_t sz) { size = sz | (size & FLAGS); }
+
+			MOS_INLINE inline bool
+			is_free() const { return size & FREE; }
+
+			MOS_INLINE inline bool
+			is_prev_free() const { return size & PREV_FREE; }
+
+			MOS_INLINE inline void
+			set_flag(Size_t flag, bool on) { size = on ? (size | flag) : (size & ~flag); }
+
+			MOS_INLINE inline void*
+			payload() { return &next_free; }
+
+			MOS_INLINE inline Block_t*
+			next_phys() { return (Block_t*) ((uint8_t*) payload() + get_size()); }
+
+			MOS_INLINE static inline Block_t*
+			from(void* ptr) { return (Block_t*) ((uint8_t*) ptr - offsetof(Block_t, next_free)); }
+		};
+
+		static constexpr Size_t HEAD = offsetof(Block_t, next_free), // Header of a used block
+		                        MIN  = sizeof(Block_t) - HEAD;       // Payload to hold free links
+
+		static_assert(HEAD % ALIGN == 0 && MIN % ALIGN == 0);
+
+		using Lists_t = Block_t* [FL_COUNT][SL_COUNT];
+
+		alignas(ALIGN) uint8_t region[SIZE];
+
+		bool ready         = false;
+		Size_t fl_bitmap   = 0;
+		Size_t sl_bitmap[FL_COUNT] = {0};
+		Lists_t blocks     = {{nullptr}};
+		Stats_t stats;
+
+		// The whole region as one free block followed by a used sentinel
+		void init()
+		{
+			auto block       = (Block_t*) region;
+			block->prev_phys = nullptr;
+			block->size      = Block_t::FREE;
+			block->set_size(SIZE - 2 * HEAD);
+
+			auto sentinel       = block->next_phys();
+			sentinel->prev_phys = block;
+			sentinel->size      = Block_t::PREV_FREE; // Size 0 and used
+
+			ready       = true;
+			stats.total = block->get_size();
+			insert_free(block);
+		}
+
+		MOS_INLINE static inline Size_t
+		align_up(Size_t x) { return (x + ALIGN - 1) & ~(ALIGN - 1); }
+
+		MOS_INLINE static inline Size_t
+		adjust(Size_t size)
+		{
+			if (size == 0 || size > SIZE) return 0;
+			const auto sz = align_up(size);
+			return sz < MIN ? MIN : sz;
+		}
+
+		MOS_INLINE static inline void
+		mapping_insert(Size_t size, Size_t& fl, Size_t& sl)
+		{
+			if (size < SMALL_BLOCK) {
+				fl = 0;
+				sl = size / (SMALL_BLOCK / SL_COUNT);
+			}
+			else {
+				const Size_t t = 31 - __builtin_clz(size);
+				sl             = (size >> (t - SL_LOG2)) ^ SL_COUNT;
+				fl             = t - FL_SHIFT + 1;
+			}
+		}
+
+		// Round up to the next list, so any block found there is large enough
+		MOS_INLINE static inline void
+		mapping_search(Size_t size, Size_t& fl, Size_t& sl)
+		{
+			if (size >= SMALL_BLOCK) {
+				size += (1 << (31 - __builtin_clz(size) - SL_LOG2)) - 1;
+			}
+			mapping_insert(size, fl, sl);
+		}
+
+		Block_t* search_suitable(Size_t& fl, Size_t& sl)
+		{
+			if (fl >= FL_COUNT) return nullptr;
+
+			auto sl_map = sl_bitmap[fl] & (~0U << sl);
+			if (sl_map == 0) {
+				const auto fl_map = (fl + 1 < 32) ? fl_bitmap & (~0U << (fl + 1)) : 0;
+				if (fl_map == 0) return nullptr;
+				fl     = __builtin_ctz(fl_map);
+				sl_map = sl_bitmap[fl];
+			}
+			sl = __builtin_ctz(sl_map);
+			return blocks[fl][sl];
+		}
+
+		void insert_free(Block_t* block)
+		{
+			Size_t fl, sl;
+			mapping_insert(block->get_size(), fl, sl);
+
+			auto& head       = blocks[fl][sl];
+			block->next_free = head;
+			block->prev_free = nullptr;
+			if (head) head->prev_free = block;
+			head = block;
+
+			fl_bitmap |= (1U << fl);
+			sl_bitmap[fl] |= (1U << sl);
+		}
+
+		void remove_free(Block_t* block, Size_t fl, Size_t sl)
+		{
+			auto prev = block->prev_free,
+			     next = block->next_free;
+
+			if (next) next->prev_free = prev;
+			if (prev) prev->next_free = next;
+			else {
+				blocks[fl][sl] = next;
+				if (next == nullptr) {
+					sl_bitmap[fl] &= ~(1U << sl);
+					if (sl_bitmap[fl] == 0) {
+						fl_bitmap &= ~(1U << fl);
+					}
+				}
+			}
+		}
+
+		MOS_INLINE inline void
+		remove_free(Block_t* block)
+		{
+			Size_t fl, sl;
+			mapping_insert(block->get_size(), fl, sl);
+			remove_free(block, fl, sl);
+		}
+
+		// Trim `block` to `size`, the rest becomes a new free block
+		void split(Block_t* block, Size_t size)
+		{
+			if (block->get_size() < size + HEAD + MIN) return;
+
+			auto rest = (Block_t*) ((uint8_t*) block->payload() + size);
+			rest->size = Block_t::FREE;
+			rest->set_size(block->get_size() - size - HEAD);
+			rest->prev_phys = block;
+			block->set_size(size);
+
+			rest->next_phys()->prev_phys = rest;
+			insert_free(rest);
+			rest->next_phys()->set_flag(Block_t::PREV_FREE, true);
+		}
+
+		MOS_INLINE inline void
+		mark_used(Block_t* block)
+		{
+			block->set_flag(Block_t::FREE, false);
+			block->next_phys()->set_flag(Block_t::PREV_FREE, false);
+		}
+
+		MOS_INLINE inline void
+		mark_free(Block_t* block)
+		{
+			block->set_flag(Block_t::FREE, true);
+			auto next       = block->next_phys();
+			next->prev_phys = block;
+			next->set_flag(Block_t::PREV_FREE, true);
+		}
+
+		Block_t* merge_prev(Block_t* block)
+		{
+			if (!block->is_prev_free()) return block;
+			auto prev = block->prev_phys;
+			remove_free(prev);
+			prev->set_size(prev->get_size() + HEAD + block->get_size());
+			return prev;
+		}
+
+		Block_t* merge_next(Block_t* block)
+		{
+			auto next = block->next_phys();
+			if (!next->is_free()) return block;
+			remove_free(next);
+			block->set_size(block->get_size() + HEAD + next->get_size());
+			return block;
+		}
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,85 @@
+#ifndef _MOS_FPU_
+#define _MOS_FPU_
+
+#include "task.hpp"
+
+// Lazy FPU context switching by ownership.
+// PendSV never touches FP registers, they stay with `fpu_owner` until another task
+// executes an FP instruction, which traps into UsageFault(NOCP) to hand them over.
+// Since automatic FP stacking is disabled, ISRs must not use FPU in this mode.
+// Neither should a task execute its first FP instruction under `IrqGuard_t`, since UsageFault
+// can't be taken with PRIMASK set and escalates to HardFault, e.g. claim it by an FP op in advance.
+namespace MOS::Kernel::Fpu
+{
+	using namespace Global;
+
+	static_assert(CORE_NUM == 1, "Lazy FPU tracks a single owner");
+
+	MOS_INLINE inline void
+	save(TcbPtr_t tcb)
+	{
+		asm volatile(ARCH_FPU_SAVE_ASM ::"r"(tcb->fpu_ctx) : "r1", "memory");
+	}
+
+	MOS_INLINE inline void
+	load(TcbPtr_t tcb)
+	{
+		asm volatile(ARCH_FPU_LOAD_ASM ::"r"(tcb->fpu_ctx) : "r1", "memory");
+	}
+
+	// Used in launch, nobody owns FPU at first
+	MOS_INLINE inline void
+	init()
+	{
+		MOS_FPU_NO_AUTO_STACK();
+		MOS_USAGE_FAULT_ENABLE();
+		MOS_FPU_DISABLE();
+	}
+
+	// Used in next_tcb, only the owner can access FPU without trapping
+	MOS_INLINE inline void
+	grant(TcbPtr_t tcb)
+	{
+		if (tcb == fpu_owner) {
+			MOS_FPU_ENABLE();
+		}
+		else {
+			MOS_FPU_DISABLE();
+		}
+	}
+
+	// Hand over FP registers to `tcb`, used in UsageFault
+	inline void
+	claim(TcbPtr_t tcb)
+	{
+		MOS_FPU_ENABLE();
+		MOS_DSB();
+		MOS_ISB();
+
+		if (fpu_owner == tcb) return;
+		if (fpu_owner != nullptr) {
+			save(fpu_owner); // Spill only when the owner changes
+		}
+
+		load(tcb); // All zeros for the first use
+		fpu_owner = tcb;
+	}
+}
+
+namespace MOS::ISR
+{
+	extern "C" void
+	MOS_USAGE_FAULT_HANDLER()
+	{
+		using namespace Kernel;
+
+		// Other usage faults are not recoverable
+		MOS_ASSERT(MOS_FPU_TRAPPED(), "Usage Fault");
+		MOS_FPU_CLR_TRAP();
+
+		// Return to re-execute the trapped FP instruction
+		Fpu::claim(Task::current());
+	}
+}
+
+#endif
\ No newline at end of file
@@ -3,6 +3,11 @@
 
 #include "data_type/tcb.hpp"
 #include "data_type/bitmap.hpp"
+#include "data_type/page_pool.hpp"
+#include "data_type/tlsf.hpp"
+#include "data_type/ready_queue.hpp"
+#include "data_type/timer_wheel.hpp"
+#include "data_type/registry.hpp"
 
 #if (MOS_CONF_DEBUG_INFO == true)
 #define MOS_DEBUG_INFO MOS_USED volatile
@@ -15,29 +20,53 @@ namespace MOS::Kernel::Global
 	using namespace Macro;
 	using namespace DataType;
 
-	using Pool_t   = Page_t::Word_t[POOL_SIZE][PAGE_SIZE];
-	using Tids_t   = BitMap_t<TASK_MAX>;
+	using Pool_t   = PagePool_t<POOL_SIZE, PAGE_SIZE>;
+	using SPool_t  = PagePool_t<POOL_SMALL_SIZE, PAGE_SIZE / 2>;
+	using LPool_t  = PagePool_t<POOL_LARGE_SIZE, PAGE_SIZE * 2>;
+	using Wheel_t  = TimerWheel_t<WHEEL_SIZE>;
+	using Tasks_t  = Registry_t<TASK_MAX>;
 	using Tick_t   = TCB_t::Tick_t;
 	using TcbPtr_t = TCB_t::TcbPtr_t;
+	using Core_t   = TCB_t::Core_t;
 
-	Pool_t page_pool MOS_DEFAULT_ALIGN;
-	Tids_t tids;
+	// Page pools of size classes
+	SPool_t small_pool;
+	Pool_t page_pool;
+	LPool_t large_pool;
+
+#if (MOS_CONF_HEAP_SIZE > 0)
+	// Deterministic heap for `DYNAMIC` pages and kernel objects
+	Tlsf_t<HEAP_SIZE> heap;
+#endif
+
+	// Live tasks indexed by tid and name, also allocates tids
+	Tasks_t tasks;
+
+	// Contains tasks indexed by `Prior_t` that are `READY` to be scheduled, one per core.
+	ReadyQueue_t ready_lists[CORE_NUM];
+
+	// Contains tasks hashed by `wake_point` that are sleeping `BLOCKED` for a certain amount of time.
+	Wheel_t sleeping_list;
 
 	TcbList_t
-	    ready_list,    // Contains tasks sorted by `Prior_t` that are `READY` to be scheduled.
-	    blocked_list,  // Contains tasks that are `BLOCKED` and waiting for a certain condition.
-	    sleeping_list, // Contains tasks sorted by `delay_ticks` that are sleeping `BLOCKED` for a certain amount of time.
-	    zombie_list;   // Contains tasks that have been `TERMINATED` but resources are not yet recycled.
+	    blocked_list, // Contains tasks that are `BLOCKED` and waiting for a certain condition.
+	    zombie_list;  // Contains tasks that have been `TERMINATED` but resources are not yet recycled.
 
 	extern "C" {
 		// Put it in `extern "C"` because the name is referred in `asm("")` and don't change it.
-		// At anytime, `cur_tcb` should point to the task running currently.
+		// At anytime, `cur_tcb[core]` should point to the task running currently on that core.
 		MOS_DEBUG_INFO
-		TcbPtr_t cur_tcb = nullptr;
+		TcbPtr_t cur_tcb[CORE_NUM] = {nullptr};
 
 		MOS_DEBUG_INFO
 		Tick_t os_ticks = 0;
 
+#if (MOS_CONF_USE_HARD_FPU == true) && (MOS_CONF_LAZY_FPU == true)
+		// The task whose context stays in FP registers
+		MOS_DEBUG_INFO
+		TcbPtr_t fpu_owner = nullptr;
+#endif
+
 		// For debug only
 		MOS_DEBUG_INFO
 		DebugTcbs_t debug_tcbs {};
@@ -45,6 +74,22 @@ namespace MOS::Kernel::Global
 		MOS_DEBUG_INFO
 		char user_name[USER_NAME_SIZE] = MOS_USER_NAME;
 	}
+
+#if (MOS_CONF_CORE_NUM > 1)
+	// The task last switched out on each core, whose registers may be still being saved after `next_tcb`
+	TcbPtr_t switched_out[CORE_NUM] = {nullptr};
+#endif
+
+	// Index of the core running the caller
+	MOS_INLINE inline Core_t
+	core_id() { return MOS_CORE_ID(); }
+
+	MOS_INLINE inline ReadyQueue_t&
+	ready_on(Core_t core) { return ready_lists[core]; }
+
+	// The ready queue that `tcb` is scheduled in
+	MOS_INLINE inline ReadyQueue_t&
+	ready_of(TCB_t::ConstTcbPtr_t tcb) { return ready_on(tcb->get_core()); }
 }
 
 #endif
\ No newline at end of file
@@ -13,26 +13,142 @@ namespace MOS::Kernel::IPC
 	using DataType::List_t;
 	using DataType::Queue_t;
 
-	template <typename T, size_t N>
-	struct MsgQueue_t
+	// Waiting and waking of senders/receivers shared by message queues
+	struct MsgQueueImpl_t
 	{
 		using Tick_t         = TCB_t::Tick_t;
-		using RawQueue_t     = Queue_t<T, N>;
 		using EventList_t    = List_t;
 		using NodePtr_t      = List_t::NodePtr_t;
 		using ConstNodePtr_t = List_t::ConstNodePtr_t;
 
+		enum Status : bool
+		{
+			Ok      = true,
+			TimeOut = !Ok,
+		};
+
+		// Called after sending outside critical sections, e.g. to resume an awaiting coroutine
+		using Notify_t = void (*)(MsgQueueImpl_t*);
+
+	protected:
+		EventList_t senders, receivers;
+		Notify_t on_send = nullptr;
+
+		MOS_INLINE inline void
+		notify()
+		{
+			if (on_send) on_send(this);
+		}
+
+		MOS_INLINE static inline auto
+		into_tcb(ConstNodePtr_t event)
+		{
+			return container_of(event, TCB_t, event);
+		}
+
+		static Status
+		check_for(EventList_t& src)
+		{
+			IrqGuard_t guard;
+			auto cur = Task::current();
+			if (cur->in_event()) {
+				// Still in event-linked -> Timeout
+				src.remove(cur->event);
+				return TimeOut;
+			}
+			return Ok;
+		}
+
+		static Status
+		wait_on(EventList_t& dest, Tick_t timeout)
+		{
+			// Priority & WakePoint Compare
+			auto pri_wkpt_cmp =
+			    [](const auto& _lhs, const auto& _rhs) {
+				    auto lhs = into_tcb(&_lhs),
+				         rhs = into_tcb(&_rhs);
+
+				    // Compare pri first, then wkpt
+				    return TCB_t::pri_cmp(lhs, rhs) &&
+				           TCB_t::wkpt_cmp(lhs, rhs);
+			    };
+
+			if (timeout == 0)
+				return TimeOut;
+
+			{
+				IrqGuard_t guard;
+				auto cur = Task::current();
+
+				// Sleep until timeout on the timer wheel, and wkpt is set before sorting
+				Task::sleep_raw(cur, timeout);
+				dest.insert_in_order(cur->event, pri_wkpt_cmp);
+				Task::yield();
+			}
+
+			// After being awakened, check for timeout
+			return check_for(dest);
+		}
+
+		// Wake up to `n` waiters, and yield at most once
+		static void
+		try_wake_up(EventList_t& src, uint32_t n = 1)
+		{
+			auto wake_up = [&](NodePtr_t event) {
+				Task::wake_raw(into_tcb(event));
+				src.remove(*event);
+			};
+
+			IrqGuard_t guard;
+			if (!src.empty() && n != 0) {
+				do {
+					wake_up(src.begin());
+				} while (!src.empty() && --n != 0);
+
+				if (Task::any_higher()) {
+					return Task::yield();
+				}
+			}
+		}
+	};
+
+	template <typename T, size_t N>
+	struct MsgQueue_t : public MsgQueueImpl_t
+	{
+		using RawQueue_t = Queue_t<T, N>;
+
+		struct RecvMsg_t
+		{
+			Status status = TimeOut;
+			T msg {};
+
+			MOS_INLINE inline void
+			ok_or(auto&& fn, auto&& oops)
+			{
+				if (status == Ok)
+					fn(msg);
+				else
+					oops();
+			}
+		};
+
 		MOS_INLINE inline bool
 		full() const { return queue.full(); }
 
 		MOS_INLINE inline bool
 		empty() const { return queue.empty(); }
 
-		enum Status : bool
+		MOS_INLINE inline uint32_t
+		size() const { return queue.size(); }
+
+		// Receivers are woken only when `size() >= mark` or the queue is full,
+		// and messages below the mark are still delivered when a receiver times out.
+		MOS_INLINE inline void
+		set_watermark(uint32_t mark)
 		{
-			Ok      = true,
-			TimeOut = !Ok,
-		};
+			MOS_ASSERT(mark != 0 && mark <= N, "Invalid watermark");
+			watermark = mark;
+		}
 
 		auto send(const T& msg, Tick_t timeout = 0)
 		{
@@ -46,7 +162,10 @@ namespace MOS::Kernel::IPC
 				queue.push(msg);
 			}
 
-			try_wake_up(receivers);
+			if (reach_mark()) {
+				try_wake_up(receivers);
+				notify();
+			}
 			return Ok;
 		}
 
@@ -55,103 +174,223 @@ namespace MOS::Kernel::IPC
 			RecvMsg_t res;
 
 			if (queue.empty() &&
-			    wait_on(receivers, timeout) == TimeOut) {
+			    wait_on(receivers, timeout) == TimeOut &&
+			    queue.empty()) {
 				return res;
 			}
 
 			{
 				IrqGuard_t guard;
-				res.status = Ok;
-				res.msg    = queue.serve();
+				if (!queue.empty()) {
+					res.status = Ok;
+					res.msg    = queue.serve();
+				}
 			}
 
 			try_wake_up(senders);
 			return res;
 		}
 
-	private:
-		EventList_t senders, receivers;
-		RawQueue_t queue;
+		// Send up to `n` messages in one critical section, return the number sent
+		uint32_t send_n(const T* msgs, uint32_t n, Tick_t timeout = 0)
+		{
+			if (queue.full() &&
+			    wait_on(senders, timeout) == TimeOut) {
+				return 0;
+			}
 
-		struct RecvMsg_t
+			uint32_t cnt = 0;
+			{
+				IrqGuard_t guard;
+				for (; cnt < n && !queue.full(); cnt++) {
+					queue.push(msgs[cnt]);
+				}
+			}
+
+			if (reach_mark()) {
+				try_wake_up(receivers, cnt);
+				notify();
+			}
+			return cnt;
+		}
+
+		// Receive up to `n` messages in one critical section, return the number received
+		uint32_t recv_n(T* msgs, uint32_t n, Tick_t timeout = 0)
 		{
-			Status status = TimeOut;
-			T msg {};
+			if (queue.empty() &&
+			    wait_on(receivers, timeout) == TimeOut &&
+			    queue.empty()) {
+				return 0;
+			}
 
-			MOS_INLINE inline void
-			ok_or(auto&& fn, auto&& oops)
+			uint32_t cnt = 0;
 			{
-				if (status == Ok)
-					fn(msg);
-				else
-					oops();
+				IrqGuard_t guard;
+				for (; cnt < n && !queue.empty(); cnt++) {
+					msgs[cnt] = queue.serve();
+				}
 			}
+
+			try_wake_up(senders, cnt);
+			return cnt;
+		}
+
+		// Consume all queued messages without blocking, popped in batches of `DRAIN_BATCH` each under
+		// one critical section, and `fn` runs on a batch outside it
+		uint32_t drain(auto&& fn)
+		{
+			// Raw copies as the queue stores, so `T` needs no default constructor
+			alignas(T) uint8_t batch[DRAIN_BATCH][sizeof(T)];
+
+			uint32_t cnt = 0, n;
+			do {
+				n = 0;
+				{
+					IrqGuard_t guard;
+					for (; n < DRAIN_BATCH && !queue.empty(); n++) {
+						Utils::memcpy(batch[n], (const void*) &queue.front(), sizeof(T));
+						queue.pop();
+					}
+				}
+				for (uint32_t i = 0; i < n; i++) {
+					fn(*(T*) batch[i]);
+				}
+				cnt += n;
+			} while (n == DRAIN_BATCH);
+
+			try_wake_up(senders, cnt);
+			return cnt;
+		}
+
+	private:
+		// About 64 bytes of messages on the stack of `drain` at most
+		static constexpr uint32_t DRAIN_BATCH =
+		    (sizeof(T) >= 64) ? 1 : (64 / sizeof(T) < N ? 64 / sizeof(T) : N);
+
+		RawQueue_t queue;
+		uint32_t watermark = 1;
+
+		MOS_INLINE inline bool
+		reach_mark() const
+		{
+			return queue.size() >= watermark || queue.full();
+		}
+	};
+
+	// Zero-copy variant, messages are built and consumed in place.
+	// Sender: `loan` a free slot -> fill it -> `commit`.
+	// Receiver: `fetch` a committed slot -> use it -> `release`.
+	// Only slot pointers are moved inside critical sections.
+	template <typename T, size_t N>
+	struct ZeroCopyMsgQueue_t : public MsgQueueImpl_t
+	{
+		using Slot_t      = T*;
+		using SlotQueue_t = Queue_t<Slot_t, N>;
+
+		// Where a slot is, to catch a slot returned twice or out of order
+		enum class State_t : uint8_t
+		{
+			Free,    // In `free_slots`
+			Loaned,  // Being filled by a sender
+			Queued,  // In `msgs`
+			Fetched, // Being read by a receiver
 		};
 
-		MOS_INLINE static constexpr inline auto
-		into_tcb(ConstNodePtr_t event)
+		ZeroCopyMsgQueue_t()
 		{
-			return container_of(event, TCB_t, event);
+			for (auto& slot: slots) {
+				free_slots.push(&slot);
+			}
 		}
 
-		static Status
-		check_for(EventList_t& src)
+		MOS_INLINE inline bool
+		full() const { return free_slots.empty(); }
+
+		MOS_INLINE inline bool
+		empty() const { return msgs.empty(); }
+
+		// Return a free slot to fill, nullptr if timeout
+		Slot_t loan(Tick_t timeout = 0)
 		{
+			if (free_slots.empty() &&
+			    wait_on(senders, timeout) == TimeOut) {
+				return nullptr;
+			}
+
 			IrqGuard_t guard;
-			auto cur = Task::current();
-			if (cur->in_event()) {
-				// Still in event-linked -> Timeout
-				src.remove(cur->event);
-				return TimeOut;
+			return take(free_slots, State_t::Loaned);
+		}
+
+		// Publish a loaned slot to receivers
+		void commit(Slot_t slot)
+		{
+			MOS_ASSERT(owns(slot), "Slot not in queue");
+
+			{
+				IrqGuard_t guard;
+				MOS_ASSERT(is(slot, State_t::Loaned), "Slot not loaned");
+				state_of(slot) = State_t::Queued;
+				msgs.push(slot);
 			}
-			return Ok;
+
+			try_wake_up(receivers);
 		}
 
-		static Status
-		wait_on(EventList_t& dest, Tick_t timeout)
+		// Return the oldest committed slot to read, nullptr if timeout
+		Slot_t fetch(Tick_t timeout = 0)
 		{
-			// Priority & WakePoint Compare
-			auto pri_wkpt_cmp =
-			    [](const auto& _lhs, const auto& _rhs) {
-				    auto lhs = into_tcb(&_lhs),
-				         rhs = into_tcb(&_rhs);
+			if (msgs.empty() &&
+			    wait_on(receivers, timeout) == TimeOut) {
+				return nullptr;
+			}
 
-				    // Compare pri first, then wkpt
-				    return TCB_t::pri_cmp(lhs, rhs) &&
-				           TCB_t::wkpt_cmp(lhs, rhs);
-			    };
+			IrqGuard_t guard;
+			return take(msgs, State_t::Fetched);
+		}
 
-			if (timeout == 0)
-				return TimeOut;
+		// Give a fetched (or an uncommitted loaned) slot back to senders
+		void release(Slot_t slot)
+		{
+			MOS_ASSERT(owns(slot), "Slot not in queue");
 
 			{
 				IrqGuard_t guard;
-				dest.insert_in_order(
-				    Task::current()->event, pri_wkpt_cmp
+				MOS_ASSERT(
+				    is(slot, State_t::Fetched) || is(slot, State_t::Loaned),
+				    "Slot double release"
 				);
+				state_of(slot) = State_t::Free;
+				free_slots.push(slot);
 			}
 
-			Task::delay(timeout); // Sleep until timeout
-
-			// After being awakened, check for timeout
-			return check_for(dest);
+			try_wake_up(senders);
 		}
 
-		static void
-		try_wake_up(EventList_t& src)
+	private:
+		T slots[N];
+		State_t states[N] = {}; // All `Free`
+		SlotQueue_t free_slots, msgs;
+
+		MOS_INLINE inline bool
+		owns(Slot_t slot) const
 		{
-			auto wake_up = [&](NodePtr_t event) {
-				Task::wake_raw(into_tcb(event));
-				src.remove(*event);
-			};
+			return slot >= slots && slot < slots + N;
+		}
 
-			IrqGuard_t guard;
-			if (!src.empty()) {
-				wake_up(src.begin());
-				if (Task::any_higher()) {
-					return Task::yield();
-				}
-			}
+		MOS_INLINE inline State_t&
+		state_of(Slot_t slot) { return states[slot - slots]; }
+
+		MOS_INLINE inline bool
+		is(Slot_t slot, State_t state) { return state_of(slot) == state; }
+
+		// May be taken by others between wakeup and here, then `to` the new state
+		MOS_INLINE inline Slot_t
+		take(SlotQueue_t& src, State_t to)
+		{
+			if (src.empty()) return nullptr;
+			const auto slot = src.serve();
+			state_of(slot)  = to;
+			return slot;
 		}
 	};
 }
@@ -0,0 +1,105 @@
+#ifndef _MOS_LOG_
+#define _MOS_LOG_
+
+#include "utils.hpp"
+#include "macro.hpp"
+#include "data_type/ring.hpp"
+
+// Output of drained bytes, e.g. define it to start a UART DMA transfer and wait for its completion
+#ifndef MOS_LOG_WRITE
+#define MOS_LOG_WRITE(buf, len)                    \
+	do {                                           \
+		for (uint32_t __i = 0; __i < (len); __i++) \
+			MOS_PUTCHAR((buf)[__i]);               \
+	} while (0)
+#endif
+
+namespace MOS::Kernel::Log
+{
+	using namespace Macro;
+	using Utils::IrqGuard_t;
+
+	// Formatted in the caller, then a whole line is pushed or dropped under a short critical section.
+	// The log task pops in chunks under short critical sections too, and writes out in bulk at a low priority.
+	using Ring_t   = DataType::SpscRing_t<char, LOG_BUF_SIZE>;
+	using Notify_t = void (*)();
+
+	Ring_t ring;
+
+	// Messages that didn't fit, reported by the log task
+	volatile uint32_t dropped = 0;
+
+	// Wakes up the log task on a push, from tasks and ISRs, set by the scheduler
+	Notify_t notify = nullptr;
+
+	// Set by `panic`, then the log task stops popping and leaves the ring to it
+	volatile bool panicked = false;
+
+	MOS_INLINE inline bool
+	push(const char* msg, uint32_t len)
+	{
+		IrqGuard_t guard;
+		if (Ring_t::capacity() - ring.size() < len) {
+			dropped += 1;
+			return false;
+		}
+		ring.push_n(msg, len);
+		if (notify) notify();
+		return true;
+	}
+
+	// Longer messages are truncated to `LOG_LINE_SIZE - 1` chars
+	inline int
+	printf(const char* format, ...)
+	{
+		char line[LOG_LINE_SIZE];
+
+		va_list va;
+		va_start(va, format);
+		const int ret = vsnprintf_(line, sizeof(line), format, va);
+		va_end(va);
+
+		if (ret > 0) {
+			const uint32_t len = ((uint32_t) ret < sizeof(line)) ? ret : sizeof(line) - 1;
+			push(line, len);
+		}
+		return ret;
+	}
+
+	// Write out all buffered chars, return the number written, `force` is only for `panic`
+	inline uint32_t
+	drain(bool force = false)
+	{
+		static uint32_t reported = 0;
+
+		char buf[32];
+		uint32_t cnt = 0, n;
+		while (true) {
+			{
+				IrqGuard_t guard; // Never two consumers inside `pop_n` at once
+				if (panicked && !force) return cnt;
+				n = ring.pop_n(buf, sizeof(buf));
+			}
+			if (n == 0) break;
+			MOS_LOG_WRITE(buf, n);
+			cnt += n;
+		}
+
+		if (const uint32_t lost = dropped; lost != reported) {
+			const int len = snprintf_(buf, sizeof(buf), "[log: %u dropped]\n", lost - reported);
+			MOS_LOG_WRITE(buf, (uint32_t) len);
+			reported = lost;
+		}
+		return cnt;
+	}
+
+	// Take the ring over from the log task and write out the rest, e.g. when the system halts
+	inline void
+	panic()
+	{
+		panicked = true;
+		drain(true);
+	}
+}
+
+#endif
\ No newline at end of file
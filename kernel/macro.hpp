@@ -7,19 +7,37 @@
 namespace MOS::Macro
 {
 	constexpr uint32_t TASK_MAX           = MOS_CONF_TASK_MAX;
+	constexpr uint32_t CORE_NUM           = MOS_CONF_CORE_NUM;
+	constexpr uint32_t MUTEX_SPIN         = MOS_CONF_MUTEX_SPIN;
 	constexpr uint32_t POOL_SIZE          = MOS_CONF_POOL_SIZE;
+	constexpr uint32_t POOL_SMALL_SIZE    = MOS_CONF_POOL_SMALL_SIZE;
+	constexpr uint32_t POOL_LARGE_SIZE    = MOS_CONF_POOL_LARGE_SIZE;
 	constexpr uint32_t PAGE_SIZE          = MOS_CONF_PAGE_SIZE / sizeof(uint32_t);
+	constexpr uint32_t STACK_GUARD_SIZE   = MOS_CONF_STACK_GUARD_SIZE;
+	constexpr uint32_t HEAP_SIZE          = MOS_CONF_HEAP_SIZE;
 	constexpr uint16_t TIME_SLICE         = MOS_CONF_TIME_SLICE;
 	constexpr uint32_t SYSTICK            = MOS_CONF_SYSTICK;
+	constexpr uint32_t WHEEL_SIZE         = MOS_CONF_WHEEL_SIZE;
+	constexpr uint32_t TRACE_SIZE         = MOS_CONF_TRACE_SIZE;
+	constexpr uint32_t IRQ_PROF_SITES     = MOS_CONF_IRQ_PROF_SITES;
+	constexpr uint32_t BENCH_ITERS        = MOS_CONF_BENCH_ITERS;
 	constexpr int8_t PRI_INV              = MOS_CONF_PRI_INV;
 	constexpr int8_t PRI_MAX              = MOS_CONF_PRI_MAX;
 	constexpr int8_t PRI_MIN              = MOS_CONF_PRI_MIN;
+	constexpr uint32_t LOG_BUF_SIZE       = MOS_CONF_LOG_BUF_SIZE;
+	constexpr uint32_t LOG_LINE_SIZE      = MOS_CONF_LOG_LINE_SIZE;
+	constexpr uint32_t LOG_BINARY_SIZE    = MOS_CONF_LOG_BINARY_SIZE;
 	constexpr uint32_t SHELL_BUF_SIZE     = MOS_CONF_SHELL_BUF_SIZE;
 	constexpr uint32_t SHELL_USR_CMD_SIZE = MOS_CONF_SHELL_USR_CMD_SIZE;
 	constexpr uint32_t ASYNC_TASK_MAX     = MOS_CONF_ASYNC_TASK_MAX;
+	constexpr uint32_t ASYNC_WORKERS      = MOS_CONF_ASYNC_WORKERS;
+	constexpr uint32_t ASYNC_LANES        = MOS_CONF_ASYNC_LANES;
+	constexpr uint32_t ASYNC_LANE_BUDGET  = MOS_CONF_ASYNC_LANE_BUDGET;
 	constexpr uint32_t ASYNC_TASK_SIZE    = MOS_CONF_ASYNC_TASK_SIZE;
-	constexpr uint32_t ASYNC_POOL_MAX     = MOS_CONF_ASYNC_POOL_MAX;
-	constexpr uint32_t ASYNC_FRAME_SIZE   = MOS_CONF_ASYNC_FRAME_SIZE;
+	constexpr uint32_t ASYNC_POOL_32      = MOS_CONF_ASYNC_POOL_32;
+	constexpr uint32_t ASYNC_POOL_64      = MOS_CONF_ASYNC_POOL_64;
+	constexpr uint32_t ASYNC_POOL_128     = MOS_CONF_ASYNC_POOL_128;
+	constexpr uint32_t ASYNC_POOL_256     = MOS_CONF_ASYNC_POOL_256;
 	constexpr uint8_t USER_NAME_SIZE      = MOS_CONF_USER_NAME_SIZE;
 }
 
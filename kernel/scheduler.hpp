@@ -3,6 +3,26 @@
 
 #include "task.hpp"
 
+#if (MOS_CONF_TICKLESS == true)
+#include "tickless.hpp"
+#endif
+
+#if (MOS_CONF_USE_HARD_FPU == true) && (MOS_CONF_LAZY_FPU == true)
+#include "fpu.hpp"
+#endif
+
+#if (MOS_CONF_TRACE == true)
+#include "trace.hpp"
+#endif
+
+#if (MOS_CONF_STACK_GUARD == true)
+#include "stack_guard.hpp"
+#endif
+
+#if (MOS_CONF_PRINTF == true) && (MOS_CONF_LOG_ASYNC == true)
+#include "sync.hpp"
+#endif
+
 namespace MOS::Kernel::Scheduler
 {
 	enum class Status : bool
@@ -51,10 +71,9 @@ namespace MOS::Kernel::Scheduler
 		// If `st` has higher priority, the current task `cr` will be set to `READY` status and switched to `st`.
 		// If the `time slice` of the current task `cr` is exhausted (i.e., `cr->time_slice <= 0`),
 		// the `time_slice` will be reset to `TIME_SLICE`, and switched to the next.
-		// If there are other tasks with the same priority as `cr` that are ready
-		// to run (i.e., `nx != ed && pri(nx) == pri(cr)`),
-		// the scheduler will perform `RoundRobin` scheduling among these tasks (so called a `PriGroup`).
-		// Otherwise, the scheduler switches back to `st` with the highest priority.
+		// Each priority level of `ready_list` is a FIFO (so called a `PriGroup`),
+		// `cr` is rotated to the tail of its level and the new head of the highest level is selected,
+		// which performs `RoundRobin` scheduling among the tasks with the same priority as `cr`.
 		PreemptPri,
 	};
 
@@ -67,6 +86,9 @@ namespace MOS::Kernel::Scheduler
 	using enum Status;
 	using enum Policy;
 
+	// Count of context switches avoided since the same task is selected
+	MOS_DEBUG_INFO static uint32_t skip_cnt = 0;
+
 	MOS_INLINE inline bool
 	is_ready() { return sched_status == Status::Ok; }
 
@@ -81,24 +103,29 @@ namespace MOS::Kernel::Scheduler
 		asm volatile(ARCH_CONTEXT_SWITCH_ASM);
 	}
 
-	// Start scheduling
+	// Start scheduling, each core calls it once to run its own idle task
 	template <typename Hook_t = void (*)()>
 	static inline void
 	launch(Hook_t hook = nullptr)
 	{
-		static uint32_t ipb[PAGE_SIZE / 2] MOS_DEFAULT_ALIGN; // Idle Page Block
+		static uint32_t ipb[CORE_NUM][PAGE_SIZE / 2] MOS_DEFAULT_ALIGN; // Idle Page Block
+
+		const auto core = core_id();
 
 		// Memory space allocated to the idle task
 		Page_t idle_page {
 		    .policy = Page_t::Policy::STATIC,
-		    .raw    = ipb,
-		    .size   = sizeof(ipb) / sizeof(uint32_t),
+		    .raw    = ipb[core],
+		    .size   = sizeof(ipb[core]) / sizeof(uint32_t),
 		};
 
 		// Default idle can be replaced by user-defined hook
 		auto idle = [] {
 			while (true) { // Recycle resources
 				Task::recycle();
+#if (MOS_CONF_TICKLESS == true)
+				Tickless::sleep(); // Suppress ticks until the next wakeup
+#endif
 			}
 
 			// while (true) { // Wait for Interrupt
@@ -106,15 +133,50 @@ namespace MOS::Kernel::Scheduler
 			// }
 		};
 
+#if (MOS_CONF_PRINTF == true) && (MOS_CONF_LOG_ASYNC == true)
+		if (core == 0) { // Write out buffered logs in bulk, just above idle
+			static Sync::Sema_t pushed {0};
+
+			// Binary, posted only if not yet, and blocks nothing in the pusher
+			Log::notify = [] {
+				if (pushed.cnt <= 0) pushed.up_from_isr();
+			};
+
+			auto log = [] {
+				while (true) {
+					if (Log::drain() == 0) {
+						pushed.down(); // Sleep until the next push, no polling ticks
+					}
+				}
+			};
+			const auto tcb = Task::create(log, nullptr, PRI_MIN - 1, "log");
+			MOS_ASSERT(tcb != nullptr, "Log Spawn Failed!");
+		}
+#endif
+
 		Task::create( // Create the idle task with a selected hook fn, or just as default
 		    hook ? hook : idle,
 		    nullptr, PRI_MIN, "idle", idle_page
 		);
 
+		auto& ready_list = ready_on(core);
 		MOS_ASSERT(!ready_list.empty(), "OS Launch Failed!");
 
-		cur_tcb = ready_list.begin(); // Point to the first task
-		cur_tcb->set_status(RUNNING); // Setup running status
+		auto& cur = cur_tcb[core];
+		cur       = ready_list.top(); // Point to the first task
+		cur->set_status(RUNNING);     // Setup running status
+#if (MOS_CONF_USE_HARD_FPU == true) && (MOS_CONF_LAZY_FPU == true)
+		Fpu::init(); // Hand over FPU on demand
+#endif
+#if (MOS_CONF_STACK_GUARD == true)
+		StackGuard::init(); // Guard the stack of the first task
+#endif
+#if (MOS_CONF_TRACE == true) || (MOS_CONF_IRQ_PROF == true) || (MOS_CONF_BENCH == true)
+		MOS_CYCLES_INIT(); // Start counting cycles on this core
+#endif
+#if (MOS_CONF_TRACE == true)
+		Trace::init();
+#endif
 		sched_status = Status::Ok;    // Enable Scheduling
 		init();                       // Jump to Scheduler
 	}
@@ -125,25 +187,17 @@ namespace MOS::Kernel::Scheduler
 	{
 		auto switch_to = [](TcbPtr_t tcb) {
 			tcb->set_status(RUNNING);
-			cur_tcb = tcb;
-			debug_tcbs.mark(cur_tcb); // For debug only
+			cur_tcb[core_id()] = tcb;
+			debug_tcbs.mark(tcb); // For debug only
 		};
 
-		auto wake_up_sleeper = [] { // sleeping_list is always sorted
-			auto tcb = sleeping_list.begin();
-			while (tcb != sleeping_list.end()) {
-				if (os_ticks < tcb->get_wkpt()) return;
-				Task::wake_raw(tcb);
-				tcb = sleeping_list.begin(); // check next sleeper
-			}
-		};
+		// Batch expiry of all sleepers due since the last call
+		sleeping_list.expire(os_ticks, Task::wake_raw);
 
-		wake_up_sleeper();
+		auto& ready_list = ready_on(core_id());
 
-		auto st = ready_list.begin(),
-		     ed = ready_list.end(),
-		     cr = Task::current(),
-		     nx = cr->next();
+		auto st = ready_list.top(),
+		     cr = Task::current();
 
 		if (cr->is_status(TERMINATED) ||
 		    cr->is_status(BLOCKED)) {
@@ -161,12 +215,8 @@ namespace MOS::Kernel::Scheduler
 				cr->time_slice = TIME_SLICE;
 				cr->set_status(READY);
 				// RoundRobin under same priority
-				if (nx != ed && TCB_t::pri_equal(nx, cr)) {
-					return switch_to(nx);
-				}
-				else {
-					return switch_to(st);
-				}
+				ready_list.rotate(cr);
+				return switch_to(ready_list.top());
 			}
 		}
 	}
@@ -175,7 +225,47 @@ namespace MOS::Kernel::Scheduler
 	extern "C" MOS_USED MOS_INLINE inline void
 	next_tcb()
 	{
+#if (MOS_CONF_CORE_NUM > 1)
+		Utils::IrqGuard_t::enter(); // IRQs are disabled in PendSV, only take the kernel lock
+#endif
+		const auto prev = Task::current();
+#if (MOS_CONF_TRACE == true)
+		const auto now = Trace::charge_raw(); // Cycles of `prev` till PendSV
+#endif
 		next_tcb<Policy::MOS_CONF_SCHED_POLICY>();
+#if (MOS_CONF_TRACE == true)
+		Trace::on_switch(prev, now);
+#endif
+		if (Task::current() == prev) {
+			skip_cnt += 1; // PendSV returns without swapping registers
+		}
+		else {
+#if (MOS_CONF_CORE_NUM > 1)
+			switched_out[core_id()] = prev; // Not to be recycled until the next switch on this core
+#endif
+#if (MOS_CONF_USE_HARD_FPU == true) && (MOS_CONF_LAZY_FPU == true)
+			Fpu::grant(Task::current()); // Trap FP instructions of non-owners
+#endif
+#if (MOS_CONF_STACK_GUARD == true)
+			StackGuard::arm(Task::current()); // Move the guard to the next stack
+#endif
+		}
+#if (MOS_CONF_CORE_NUM > 1)
+		Utils::IrqGuard_t::leave();
+#endif
+	}
+
+	// Used in SysTick, whether `next_tcb` may select another task
+	MOS_INLINE inline bool
+	need_switch()
+	{
+		// Wake up due sleepers here, since they may preempt
+		sleeping_list.expire(os_ticks, Task::wake_raw);
+
+		auto cr = Task::current();
+		return !cr->is_status(RUNNING) ||
+		       cr->time_slice <= 0 ||
+		       Task::any_higher(cr);
 	}
 }
 
@@ -197,12 +287,26 @@ namespace MOS::ISR
 			using namespace Utils;
 
 			IrqGuard_t guard;
-			Task::inc_ticks();
+			if (Global::core_id() == 0) {
+				Task::inc_ticks(); // Only the first core counts ticks
+			}
 			if (Scheduler::is_ready()) {
 				Task::dec_tmslc();
-				return Task::yield();
+				if (Scheduler::need_switch()) {
+					return Task::yield();
+				}
+				Scheduler::skip_cnt += 1; // Not even trigger PendSV
 			}
 		}
+
+#if (MOS_CONF_CORE_NUM > 1)
+		// Another core asks this core to reschedule
+		void MOS_IPI_HANDLER()
+		{
+			MOS_IPI_CLEAR();
+			Kernel::Task::yield();
+		}
+#endif
 	}
 }
 
@@ -0,0 +1,78 @@
+#ifndef _MOS_STACK_GUARD_
+#define _MOS_STACK_GUARD_
+
+#include "task.hpp"
+
+// MPU guard of task stacks.
+// A no-access region lies between the tcb and the stack of the running task on each core, moved in `next_tcb`.
+// Overflowing into it raises MemManage, which terminates only the running task and switches away.
+// A frame larger than the guard may still jump over it, and faults with IRQs disabled escalate to HardFault.
+namespace MOS::Kernel::StackGuard
+{
+	using namespace Global;
+	using Utils::IrqGuard_t;
+
+	static_assert(
+	    STACK_GUARD_SIZE >= 32 && (STACK_GUARD_SIZE & (STACK_GUARD_SIZE - 1)) == 0,
+	    "Stack guard must be a power of 2 and >= 32 bytes"
+	);
+
+	// Tasks terminated for overflowing
+	MOS_DEBUG_INFO static uint32_t kill_cnt = 0;
+
+	// Used in next_tcb, before PendSV swaps the stacks
+	MOS_INLINE inline void
+	arm(TcbPtr_t tcb) { MOS_MPU_GUARD(tcb->stack_guard()); }
+
+	// Used in launch, after the first task is selected
+	MOS_INLINE inline void
+	init() { MOS_MPU_INIT(Task::current()->stack_guard(), STACK_GUARD_SIZE); }
+
+	// Whether the fault is raised by `tcb` accessing its guard, including exception stacking onto it
+	MOS_INLINE inline bool
+	is_overflow(TcbPtr_t tcb)
+	{
+		if (!MOS_FAULT_FROM_THREAD()) {
+			return false; // Handlers run on MSP
+		}
+		if (MOS_MPU_STACKING_FAULT()) {
+			return true;
+		}
+		const uint32_t addr = MOS_MPU_FAULT_ADDR() - tcb->stack_guard();
+		return addr < STACK_GUARD_SIZE;
+	}
+
+	// Never return to `tcb`, PendSV is tail-chained after the fault
+	inline void
+	kill(TcbPtr_t tcb)
+	{
+		IrqGuard_t guard;
+
+		// PendSV still pushes registers below PSP, move it off the guard and the tcb
+		MOS_SET_PSP((uint32_t) &tcb->page.from_bottom());
+
+		kill_cnt += 1;
+		Task::terminate_raw(tcb);
+		Task::yield();
+	}
+}
+
+namespace MOS::ISR
+{
+	extern "C" void
+	MOS_MEM_FAULT_HANDLER()
+	{
+		using namespace Kernel;
+
+		const auto tcb = Task::current();
+
+		// Other memory faults are not recoverable
+		MOS_ASSERT(StackGuard::is_overflow(tcb), "MemManage Fault");
+		MOS_MPU_CLR_FAULT();
+
+		BLOG("Task '%s' stack overflow, terminated", tcb->get_name());
+		StackGuard::kill(tcb);
+	}
+}
+
+#endif
\ No newline at end of file
@@ -11,6 +11,8 @@ namespace MOS::Kernel::Sync
 
 	using DataType::TCB_t;
 	using DataType::TcbList_t;
+	using DataType::PiNode_t;
+	using DataType::List_t;
 
 	using TcbPtr_t = TCB_t::TcbPtr_t;
 	using Prior_t  = TCB_t::Prior_t;
@@ -137,19 +139,7 @@ namespace MOS::Kernel::Sync
 			// Priority Inheritance Protocol (PIP) logic
 			// If the lock is already held by another task (owner), check if we need to
 			// boost the owner's priority to avoid priority inversion.
-			if (owner != nullptr) {
-				auto owner_pri = owner->get_pri();
-				auto cur_pri   = cur->get_pri();
-
-				// In MOS, a smaller priority value means higher priority.
-				// If current task has higher priority than the owner:
-				if (pri_cmp(cur_pri, owner_pri)) {
-					// Temporarily boost the owner's priority to the current task's level.
-					// Note: You must ensure TCB_t::store_pri() handles this correctly
-					// (i.e., only update if new_pri < old_pri).
-					owner->store_pri(cur_pri);
-				}
-			}
+			inherit_raw(cur);
 
 			// Semaphore Wait (Dijkstra's Algorithm)
 			sema.cnt -= 1;
@@ -178,6 +168,62 @@ namespace MOS::Kernel::Sync
 			);
 
 			IrqGuard_t guard;
+			unlock_raw();
+
+			// If the woken task has a higher priority than the current task
+			// (which is likely if we just did priority inheritance), yield now.
+			if (Task::any_higher()) {
+				return Task::yield();
+			}
+		}
+
+		// Helper for RAII-style locking
+		MOS_INLINE inline auto
+		hold(auto&& scope)
+		{
+			lock();
+			scope();
+			unlock();
+		}
+
+	private:
+		friend struct CondVar_t;
+
+		Sema_t sema       = 1;
+		Count_t recursive = 0;
+		TcbPtr_t owner    = nullptr;
+
+		// Helper to compare priorities.
+		// Returns true if lhs has higher priority (smaller value) than rhs.
+		MOS_INLINE static inline bool
+		pri_cmp(Prior_t lhs, Prior_t rhs)
+		{
+			return lhs < rhs;
+		}
+
+		MOS_INLINE inline void
+		inherit_raw(TcbPtr_t tcb)
+		{
+			if (owner != nullptr) {
+				auto owner_pri = owner->get_pri();
+				auto tcb_pri   = tcb->get_pri();
+
+				// In MOS, a smaller priority value means higher priority.
+				// If the waiter has higher priority than the owner:
+				if (pri_cmp(tcb_pri, owner_pri)) {
+					// Temporarily boost the owner's priority to the waiter's level.
+					// Note: You must ensure TCB_t::store_pri() handles this correctly
+					// (i.e., only update if new_pri < old_pri).
+					Task::change_pri_raw(owner, [tcb_pri](TcbPtr_t tcb) {
+						tcb->store_pri(tcb_pri);
+					});
+				}
+			}
+		}
+
+		// Unlock without yielding, under `IrqGuard_t`
+		void unlock_raw()
+		{
 			recursive -= 1;
 
 			// If it's a recursive lock and not fully released yet, just return.
@@ -189,7 +235,9 @@ namespace MOS::Kernel::Sync
 			// When releasing the lock, the owner returns to its original priority.
 			// (Note: This simple logic assumes non-nested PIP. Nested locks require
 			// a stack of priorities in TCB, but this suffices for basic usage).
-			owner->restore_pri();
+			Task::change_pri_raw(owner, [](TcbPtr_t tcb) {
+				tcb->restore_pri();
+			});
 			owner = nullptr; // Drop Ownership
 
 			// Wake up waiters (if any)
@@ -210,12 +258,6 @@ namespace MOS::Kernel::Sync
 				// We wake one up, so we theoretically increment cnt.
 				// Logic: -1 (1 waiter) -> 0 (lock held by new owner, 0 waiters).
 				sema.cnt += 1;
-
-				// If the woken task has a higher priority than the current task
-				// (which is likely if we just did priority inheritance), yield now.
-				if (Task::any_higher()) {
-					return Task::yield();
-				}
 			}
 			else {
 				// No waiters. Just release the semaphore resource.
@@ -224,26 +266,20 @@ namespace MOS::Kernel::Sync
 			}
 		}
 
-		// Helper for RAII-style locking
-		MOS_INLINE inline auto
-		hold(auto&& scope)
-		{
-			lock();
-			scope();
-			unlock();
-		}
-
-	private:
-		Sema_t sema       = 1;
-		Count_t recursive = 0;
-		TcbPtr_t owner    = nullptr;
-
-		// Helper to compare priorities.
-		// Returns true if lhs has higher priority (smaller value) than rhs.
-		MOS_INLINE static inline bool
-		pri_cmp(Prior_t lhs, Prior_t rhs)
+		// Move a blocked `tcb` from `src` to acquire the lock (wait morphing):
+		// it's resumed as the owner if the lock is free, or queued as a waiter otherwise.
+		void enqueue_raw(TcbPtr_t tcb, TcbList_t& src)
 		{
-			return lhs < rhs;
+			sema.cnt -= 1;
+			if (sema.cnt < 0) {
+				inherit_raw(tcb);
+				src.send_to(tcb, sema.waiting_list);
+			}
+			else {
+				owner     = tcb;
+				recursive = 1;
+				Task::resume_raw(tcb, src);
+			}
 		}
 	};
 
@@ -319,6 +355,176 @@ namespace MOS::Kernel::Sync
 	template <typename T>
 	Mutex_t(T&) -> Mutex_t<T&>;
 
+	// Mutex with transitive priority inheritance.
+	// Locks owned are chained in the owner's TCB, so the owner runs at the highest priority
+	// among waiters of all its locks. A boost follows the chain of owners blocked on other locks,
+	// and each of them is re-sorted in the ready queue or in the waiters where it's queued.
+	// On SMP, a lock held by a task running on another core is polled `MUTEX_SPIN` times first.
+	struct PiMutex_t : private PiNode_t
+	{
+		PiMutex_t() = default;
+
+		// Disable copying, it's linked by the owner
+		PiMutex_t(const PiMutex_t&)            = delete;
+		PiMutex_t& operator=(const PiMutex_t&) = delete;
+
+		void lock()
+		{
+			MOS_ASSERT(test_irq(), "Disabled Interrupt");
+
+			for (uint32_t spin = 0;; spin++) {
+				IrqGuard_t guard;
+				auto cur = Task::current();
+
+				if (owner == cur) {
+					recursive += 1;
+					return;
+				}
+
+				if (owner == nullptr) {
+					return take(cur);
+				}
+
+				// Spin with interrupts enabled, as the holder may release soon
+				if (spin < MUTEX_SPIN && held_elsewhere()) {
+					continue;
+				}
+
+				// Wait in order of priority and boost the chain of owners,
+				// the lock is handed over by `unlock` before being resumed.
+				cur->waiting = this;
+				Task::block_to_in_order_raw(cur, waiters, TCB_t::pri_cmp);
+				propagate(this);
+				return Task::yield();
+			}
+		}
+
+		void unlock()
+		{
+			MOS_ASSERT(test_irq(), "Disabled Interrupt");
+			IrqGuard_t guard;
+
+			auto cur = Task::current();
+			MOS_ASSERT(owner == cur, "Lock can only be released by holder");
+
+			recursive -= 1;
+			if (recursive > 0) {
+				return;
+			}
+
+			drop(cur);
+			update(cur); // Give back what's inherited from this lock
+
+			if (waiters.empty()) {
+				owner = nullptr;
+				return;
+			}
+
+			// Hand over to the highest waiter, which inherits from the rest
+			auto next = waiters.begin();
+			Task::resume_raw(next, waiters);
+			next->waiting = nullptr;
+			take(next);
+			update(next);
+
+			if (Task::any_higher()) {
+				return Task::yield();
+			}
+		}
+
+		// Helper for RAII-style locking
+		MOS_INLINE inline auto
+		hold(auto&& scope)
+		{
+			lock();
+			scope();
+			unlock();
+		}
+
+		MOS_INLINE inline TcbPtr_t
+		get_owner() const { return owner; }
+
+	private:
+		Count_t recursive = 0;
+
+		MOS_INLINE inline bool
+		held_elsewhere() const
+		{
+			if constexpr (CORE_NUM > 1) {
+				return owner->is_status(TCB_t::RUNNING) &&
+				       owner->get_core() != Global::core_id();
+			}
+			return false;
+		}
+
+		MOS_INLINE inline void
+		take(TcbPtr_t tcb)
+		{
+			owner      = tcb;
+			recursive  = 1;
+			next       = tcb->owned;
+			tcb->owned = this;
+		}
+
+		// Unlink from the locks owned by `tcb`
+		MOS_INLINE inline void
+		drop(TcbPtr_t tcb)
+		{
+			if (tcb->owned == this) {
+				tcb->owned = next;
+			}
+			else { // No pointer into the packed TCB
+				auto it = tcb->owned;
+				while (it->next != this) {
+					it = it->next;
+				}
+				it->next = next;
+			}
+			next = nullptr;
+		}
+
+		// Priority of `tcb` from its base and the highest waiter of each lock it owns
+		static void update(TcbPtr_t tcb)
+		{
+			auto eff = tcb->get_base_pri();
+			for (auto lock = tcb->owned; lock != nullptr; lock = lock->next) {
+				if (!lock->waiters.empty()) {
+					const auto top = lock->waiters.begin()->get_pri();
+					if (top < eff) eff = top;
+				}
+			}
+
+			if (eff == tcb->get_pri()) {
+				return; // Keep its place in the ready queue
+			}
+
+			Task::change_pri_raw(tcb, [eff](TcbPtr_t tcb) {
+				tcb->inherit_pri(eff);
+			});
+		}
+
+		// Walk the chain of owners, bounded by `TASK_MAX` in case of a deadlock cycle
+		static void propagate(PiNode_t* lock)
+		{
+			for (uint32_t depth = 0; lock != nullptr && depth < TASK_MAX; depth++) {
+				const auto tcb = lock->owner;
+				const auto old = tcb->get_pri();
+				update(tcb);
+				if (tcb->get_pri() == old) {
+					break; // No change to pass on
+				}
+
+				lock = tcb->waiting;
+				if (lock != nullptr) {
+					lock->waiters.re_insert(tcb, TCB_t::pri_cmp);
+				}
+			}
+		}
+	};
+
+	// Waiting drops the mutex and blocks in one critical section, so no notify is lost.
+	// A notified waiter is moved to the mutex (wait morphing), and becomes runnable only
+	// when it's handed the mutex, instead of waking up just to contend for it again.
 	struct CondVar_t
 	{
 		MOS_INLINE inline bool
@@ -327,24 +533,25 @@ namespace MOS::Kernel::Sync
 			return !waiting_list.empty();
 		}
 
+		// `mtx` must be held once (not recursively) by the caller, and is held on return
 		inline void
 		wait(
 		    MutexImpl_t& mtx,
 		    Invocable<bool> auto&& pred
 		)
 		{
-			// Note: There is a small window between unlock and block_this where
-			// an interrupt could occur, potentially leading to a lost wakeup if
-			// notify() is called in that window.
-			// However, since `block_to_raw` disables interrupts internally via
-			// IrqGuard logic (in Task::block_to), the critical path is mostly protected.
-			// Ideally, unlock and block should be atomic.
+			MOS_ASSERT(test_irq(), "Disabled Interrupt");
+			MOS_ASSERT(mtx.owner == Task::current() && mtx.recursive == 1, "Hold the mutex once");
 
-			mtx.unlock();     // Unlock first
 			while (!pred()) { // Avoid false wakeup
-				block_this();
+				IrqGuard_t guard;
+				MOS_ASSERT(bound == nullptr || bound == &mtx, "CondVar with another mutex");
+				bound = &mtx;
+
+				mtx.unlock_raw();
+				Task::block_to_raw(Task::current(), waiting_list);
+				Task::yield(); // Back as the owner of `mtx`
 			}
-			mtx.lock();
 		}
 
 		inline void notify() // Signal
@@ -352,38 +559,33 @@ namespace MOS::Kernel::Sync
 			IrqGuard_t guard;
 			if (has_waiters()) {
 				wake_up();
+				if (Task::any_higher()) {
+					return Task::yield();
+				}
 			}
-			return Task::yield();
 		}
 
 		inline void notify_all() // Broadcast
 		{
 			IrqGuard_t guard;
-			while (has_waiters()) {
-				wake_up();
+			if (has_waiters()) {
+				while (has_waiters()) {
+					wake_up();
+				}
+				if (Task::any_higher()) {
+					return Task::yield();
+				}
 			}
-			return Task::yield();
 		}
 
 	private:
 		TcbList_t waiting_list;
-
-		MOS_INLINE inline void
-		block_this()
-		{
-			IrqGuard_t guard;
-			Task::block_to_raw(
-			    Task::current(), waiting_list
-			);
-			return Task::yield();
-		}
+		MutexImpl_t* bound = nullptr; // The mutex used by waiters
 
 		MOS_INLINE inline void
 		wake_up()
 		{
-			Task::resume_raw(
-			    waiting_list.begin(), waiting_list
-			);
+			bound->enqueue_raw(waiting_list.begin(), waiting_list);
 		}
 	};
 
@@ -417,6 +619,139 @@ namespace MOS::Kernel::Sync
 			});
 		}
 	};
+
+	// 32 event flags, tasks wait for any or all of a mask with timeout.
+	// Setting flags wakes every satisfied waiter in one pass of one critical section,
+	// and flags to clear on exit are cleared after the pass, so all of them see the same flags.
+	struct EventGroup_t
+	{
+		using Bits_t = uint32_t;
+		using Tick_t = TCB_t::Tick_t;
+
+		// Return the satisfying flags of `mask`, or 0 if timeout
+		MOS_INLINE inline Bits_t
+		wait_any(Bits_t mask, Tick_t timeout, bool clear = true)
+		{
+			return wait(mask, timeout, false, clear);
+		}
+
+		MOS_INLINE inline Bits_t
+		wait_all(Bits_t mask, Tick_t timeout, bool clear = true)
+		{
+			return wait(mask, timeout, true, clear);
+		}
+
+		// Return the flags before clearing on exit of waiters
+		Bits_t set(Bits_t new_bits)
+		{
+			MOS_ASSERT(test_irq(), "Disabled Interrupt");
+			IrqGuard_t guard;
+			const auto res = set_raw(new_bits);
+			if (Task::any_higher()) {
+				Task::yield();
+			}
+			return res;
+		}
+
+		MOS_INLINE inline Bits_t
+		set_from_isr(Bits_t new_bits)
+		{
+			IrqGuard_t guard;
+			return set_raw(new_bits);
+		}
+
+		MOS_INLINE inline void
+		clear(Bits_t mask)
+		{
+			IrqGuard_t guard;
+			bits &= ~mask;
+		}
+
+		MOS_INLINE inline Bits_t
+		get() const { return bits; }
+
+	private:
+		// Lives on the stack of the waiting task
+		struct Waiter_t
+		{
+			List_t::Node_t node; // Must be the first
+			TcbPtr_t tcb;
+			Bits_t mask, got = 0;
+			bool all, clear;
+
+			MOS_INLINE inline bool
+			satisfied_by(Bits_t bits) const
+			{
+				const auto hit = bits & mask;
+				return all ? hit == mask : hit != 0;
+			}
+		};
+
+		List_t waiters;
+		volatile Bits_t bits = 0;
+
+		Bits_t wait(Bits_t mask, Tick_t timeout, bool all, bool clear)
+		{
+			MOS_ASSERT(test_irq(), "Disabled Interrupt");
+			MOS_ASSERT(mask != 0, "Empty mask");
+
+			Waiter_t waiter {
+			    .node  = {},
+			    .tcb   = Task::current(),
+			    .mask  = mask,
+			    .all   = all,
+			    .clear = clear,
+			};
+
+			{
+				IrqGuard_t guard;
+				if (waiter.satisfied_by(bits)) {
+					const auto got = bits & mask;
+					if (clear) bits &= ~got;
+					return got;
+				}
+
+				if (timeout == 0) {
+					return 0;
+				}
+
+				// Sleep until timeout on the timer wheel, as `MsgQueue_t`
+				Task::sleep_raw(waiter.tcb, timeout);
+				waiters.add(waiter.node);
+				Task::yield();
+			}
+
+			// Still linked after being awakened -> timeout
+			IrqGuard_t guard;
+			if (waiter.node.prev != &waiter.node) {
+				waiters.remove(waiter.node);
+				return 0;
+			}
+			return waiter.got;
+		}
+
+		Bits_t set_raw(Bits_t new_bits)
+		{
+			bits |= new_bits;
+			const Bits_t cur = bits;
+
+			Bits_t to_clear = 0;
+			for (auto it = waiters.begin(); it != waiters.end();) {
+				const auto nx = it->next;
+				auto& waiter  = *reinterpret_cast<Waiter_t*>(it);
+				if (waiter.satisfied_by(cur)) {
+					waiter.got = cur & waiter.mask;
+					if (waiter.clear) to_clear |= waiter.got;
+					waiters.remove(*it);
+					Task::wake_raw(waiter.tcb);
+				}
+				it = nx;
+			}
+
+			bits &= ~to_clear;
+			return cur;
+		}
+	};
 }
 
 #endif
\ No newline at end of file
@@ -25,16 +25,56 @@ namespace MOS::Kernel::Task
 	using enum TCB_t::Status;
 
 	MOS_INLINE inline TcbPtr_t
-	current() { return cur_tcb; }
+	current() { return cur_tcb[core_id()]; }
 
 	MOS_INLINE inline void
 	yield() { MOS_TRIGGER_PENDSV_INTR(); }
 
-	// Whether task with higher priority than tcb exists
+	// Whether task with higher priority than tcb exists on its core
 	MOS_INLINE inline bool
 	any_higher(TcbPtr_t tcb = current())
 	{
-		return tcb != ready_list.begin();
+		return ready_of(tcb).any_higher(tcb->get_pri());
+	}
+
+	// Whether `tcb` is scheduled on the caller's core
+	MOS_INLINE inline bool
+	is_local([[maybe_unused]] TcbPtr_t tcb)
+	{
+#if (MOS_CONF_CORE_NUM > 1)
+		return tcb->get_core() == core_id();
+#else
+		return true;
+#endif
+	}
+
+	// Put `tcb` into the ready queue of its core, and interrupt that core if `tcb` should preempt
+	MOS_INLINE inline void
+	ready_raw(TcbPtr_t tcb)
+	{
+		ready_of(tcb).add(tcb);
+#if (MOS_CONF_CORE_NUM > 1)
+		const auto core   = tcb->get_core();
+		const TcbPtr_t cr = cur_tcb[core];
+		if (!is_local(tcb) && cr != nullptr && TCB_t::pri_cmp(tcb, cr)) {
+			MOS_TRIGGER_IPI(core);
+		}
+#endif
+	}
+
+	// Let the core running `tcb` reschedule, used after `tcb` is no longer runnable
+	MOS_INLINE inline void
+	reschedule(TcbPtr_t tcb)
+	{
+		if (tcb == current()) {
+			return yield();
+		}
+#if (MOS_CONF_CORE_NUM > 1)
+		const auto core = tcb->get_core();
+		if (tcb == cur_tcb[core]) {
+			MOS_TRIGGER_IPI(core);
+		}
+#endif
 	}
 
 	MOS_INLINE inline void
@@ -53,19 +93,41 @@ namespace MOS::Kernel::Task
 	MOS_INLINE inline Tid_t
 	tid_alloc() // Task ID Allocation
 	{
-		auto tid = tids.first_zero();
-		tids.set(tid);
-		return tid;
+		return tasks.tid_alloc();
 	}
 
-	// Used in idle task
+	MOS_INLINE inline void
+	release(TcbPtr_t tcb)
+	{
+		const Page_t page = tcb->page; // Copy out since tcb is at the head of page
+		tcb->release();
+		pfree(page);
+	}
+
+	// Whether another core may still switch out of `tcb` and save registers onto its stack
+	MOS_INLINE inline bool
+	stack_in_use([[maybe_unused]] TcbPtr_t tcb)
+	{
+#if (MOS_CONF_CORE_NUM > 1)
+		const auto core = tcb->get_core();
+		return core != core_id() &&
+		       (tcb == cur_tcb[core] || tcb == switched_out[core]);
+#else
+		return false;
+#endif
+	}
+
+	// Used in idle task, zombies still on the stack of another core are left to the next round
 	inline void recycle()
 	{
 		IrqGuard_t guard;
-		while (!zombie_list.empty()) {
-			auto tcb = zombie_list.begin();
-			zombie_list.remove(tcb); // Remove from zombie_list
-			tcb->release();          // Release resources
+		for (auto tcb = zombie_list.begin(); tcb != zombie_list.end();) {
+			const auto next = tcb->next();
+			if (!stack_in_use(tcb)) {
+				zombie_list.remove(tcb); // Remove from zombie_list
+				release(tcb);            // Release resources
+			}
+			tcb = next;
 		}
 		return yield();
 	}
@@ -75,7 +137,7 @@ namespace MOS::Kernel::Task
 	{
 		// Remove the task from where it belongs to
 		if (tcb->is_status(RUNNING) || tcb->is_status(READY)) {
-			ready_list.remove(tcb);
+			ready_of(tcb).remove(tcb);
 		}
 		else if (tcb->is_sleeping()) {
 			sleeping_list.remove(tcb);
@@ -85,15 +147,21 @@ namespace MOS::Kernel::Task
 		}
 
 		tcb->set_status(TERMINATED); // Mark tcb as TERMINATED
-		tids.reset(tcb->get_tid());  // Clear the bit in tids
+		tasks.remove(tcb);           // Release the tid
 		debug_tcbs.remove(tcb);      // For debug only
 
-		// Only `DYNAMIC` pages need delayed recycling
-		if (tcb->page.is_policy(DYNAMIC)) {
+#if (MOS_CONF_USE_HARD_FPU == true) && (MOS_CONF_LAZY_FPU == true)
+		if (fpu_owner == tcb) {
+			fpu_owner = nullptr; // Drop the FP context of it
+		}
+#endif
+
+		// Only `DYNAMIC` pages need delayed recycling, or the stack is still in use by another core
+		if (tcb->page.is_policy(DYNAMIC) || stack_in_use(tcb)) {
 			zombie_list.add(tcb); // Add to zombie_list
 		}
 		else { // Otherwise for `POOL` or `STATIC` just release immediately
-			tcb->release();
+			release(tcb);
 		}
 	}
 
@@ -105,9 +173,7 @@ namespace MOS::Kernel::Task
 		if (tcb == nullptr || tcb->is_status(TERMINATED))
 			return;
 		terminate_raw(tcb);
-		if (tcb == current()) {
-			return yield();
-		}
+		return reschedule(tcb);
 	}
 
 	MOS_INLINE static inline void
@@ -116,8 +182,8 @@ namespace MOS::Kernel::Task
 	MOS_INLINE static inline void
 	load_context(TcbPtr_t tcb)
 	{
-		// Stack Layout Configuration
-		constexpr bool HAS_FPU      = MOS_CONF_USE_HARD_FPU;
+		// Stack Layout Configuration, lazy FPU keeps no FP context on stack
+		constexpr bool HAS_FPU      = MOS_CONF_USE_HARD_FPU && !MOS_CONF_LAZY_FPU;
 		constexpr size_t HW_CTX_LEN = 8;                                           // R0-R3, R12, LR, PC, xPSR
 		constexpr size_t SW_CTX_LEN = 8;                                           // R4-R11
 		constexpr size_t TOTAL_LEN  = HW_CTX_LEN + SW_CTX_LEN + (HAS_FPU ? 1 : 0); // extra for EXC_RETURN
@@ -130,6 +196,14 @@ namespace MOS::Kernel::Task
 		auto stack = &tcb->page.from_bottom(TOTAL_LEN);
 		tcb->set_sp((uint32_t) stack);
 
+		MOS_ASSERT(tcb->stack_limit() < stack, "Page too small");
+
+#if (MOS_CONF_STACK_PAINT == true)
+		for (auto it = tcb->stack_limit(); it < stack; it++) {
+			*it = TCB_t::STACK_PAINT;
+		}
+#endif
+
 		// Set the 'T' bit in stacked xPSR to '1' to notify processor on exception return about the Thumb state.
 		// V6-m and V7-m cores can only support Thumb state so it should always be set to '1'.
 		stack[TOP_IDX]     = (uint32_t) 0x0100'0000; // xPSR: Thumb State (T-bit = 1)
@@ -207,18 +281,22 @@ namespace MOS::Kernel::Task
 	inline TcbPtr_t // No yield() inside
 	create_raw(
 	    auto fn, auto argv, Prior_t pri,
-	    Name_t name, Page_t page
+	    Name_t name, Page_t page,
+	    Core_t core = core_id()
 	)
 	{
 		MOS_ASSERT(fn != nullptr, "fn can't be null");
+		MOS_ASSERT(pri >= PRI_MAX && pri <= PRI_MIN, "Invalid priority");
+		MOS_ASSERT(core < CORE_NUM, "Invalid core");
 
 		if (page.get_raw() == nullptr) {
-			LOG("Page Alloc Failed!");
+			BLOG("Page Alloc Failed!");
 			return nullptr;
 		}
 
-		if (debug_tcbs.size() >= TASK_MAX) {
-			LOG("Max tasks!");
+		if (tasks.size() >= TASK_MAX) {
+			BLOG("Max tasks!");
+			pfree(page); // Return the unused page
 			return nullptr;
 		}
 
@@ -233,12 +311,12 @@ namespace MOS::Kernel::Task
 		tcb->set_tid(tid_alloc()); // Set Tid
 		tcb->set_stamp(os_ticks);  // Set Timestamp
 		tcb->set_parent(cur);      // Set Parent
+		tcb->set_core(core);       // Set Affinity
 		tcb->set_status(READY);    // Set Status into READY
 
-		ready_list.insert_in_order( // Add to ready_list
-		    tcb, TCB_t::pri_cmp
-		);
+		ready_raw(tcb);            // Add to ready_list
 
+		tasks.add(tcb);      // Index by tid and name
 		debug_tcbs.add(tcb); // For debug only
 		return tcb;
 	}
@@ -256,7 +334,8 @@ namespace MOS::Kernel::Task
 	inline TcbPtr_t
 	create_impl(
 	    auto fn, auto argv, Prior_t pri,
-	    Name_t name, Page_t page
+	    Name_t name, Page_t page,
+	    Core_t core = core_id()
 	)
 	{
 		MOS_ASSERT(test_irq(), "Disabled Interrupt");
@@ -264,10 +343,11 @@ namespace MOS::Kernel::Task
 
 		{
 			IrqGuard_t guard;
-			tcb = create_raw(fn, argv, pri, name, page);
+			tcb = create_raw(fn, argv, pri, name, page, core);
 		}
 
-		if (TCB_t::pri_cmp(tcb, current())) {
+		if (core == core_id() &&
+		    TCB_t::pri_cmp(tcb, current())) {
 			yield();
 		}
 
@@ -305,6 +385,25 @@ namespace MOS::Kernel::Task
 		return create(fn, argv, pri, name, page);
 	}
 
+	MOS_INLINE inline Page_t
+	make_page() { return page_alloc(POOL, PAGE_SIZE); }
+
+	MOS_INLINE inline Page_t
+	make_page(Page_t page) { return page; }
+
+	MOS_INLINE inline Page_t
+	make_page(PageSize_t page_size) { return page_alloc(DYNAMIC, page_size); }
+
+	// Create task pinned to `core`, the page is given as in `create`: none, `Page_t` or `PageSize_t`
+	MOS_INLINE inline TcbPtr_t
+	create_on(
+	    Core_t core, auto fn, auto argv,
+	    Prior_t pri, Name_t name, auto... page
+	)
+	{
+		return create_impl(fn, argv, pri, name, make_page(page...), core);
+	}
+
 	// Not recommended to use
 	MOS_INLINE inline TcbPtr_t
 	create_from_isr(
@@ -315,6 +414,65 @@ namespace MOS::Kernel::Task
 		return create_raw(fn, argv, pri, name, page);
 	}
 
+	// Name of a task as a template argument, e.g. `StaticTask_t<fn, 5, "blink">`
+	template <size_t N>
+	struct StaticName_t
+	{
+		char str[N];
+
+		consteval StaticName_t(const char (&s)[N])
+		{
+			for (size_t i = 0; i < N; i++) {
+				str[i] = s[i];
+			}
+		}
+	};
+
+	// A task declared at compile time, the entry, priority, name, page bytes and core are all checked by `static_assert`.
+	// Only its page block is stored in the object, so a declaration at namespace scope stays in `.bss`.
+	template <
+	    auto fn, Prior_t pri, StaticName_t name,
+	    size_t BYTES = MOS_CONF_PAGE_SIZE, Core_t core = 0, auto argv = nullptr>
+	struct StaticTask_t
+	{
+		static constexpr size_t WORDS = BYTES / sizeof(uint32_t);
+
+		// The tcb, the guard with its alignment padding, and at least 64 words of stack
+		static constexpr size_t MIN_BYTES =
+		    sizeof(TCB_t) + (MOS_CONF_STACK_GUARD ? 2 * STACK_GUARD_SIZE : 0) + 64 * sizeof(uint32_t);
+
+		static_assert(fn != nullptr, "fn can't be null");
+		static_assert(pri >= PRI_MAX && pri <= PRI_MIN, "Invalid priority");
+		static_assert(core < CORE_NUM, "Invalid core");
+		static_assert(BYTES % 8 == 0, "Page must keep 8-byte alignment of stack");
+		static_assert(BYTES >= MIN_BYTES, "Page too small");
+
+		uint32_t block[WORDS] MOS_DEFAULT_ALIGN;
+
+		// Used in `boot`, the page is `STATIC` and never freed
+		MOS_INLINE inline TcbPtr_t
+		build()
+		{
+			const Page_t page {.policy = STATIC, .raw = block, .size = WORDS};
+			return create_raw(fn, argv, pri, name.str, page, core);
+		}
+	};
+
+	// Create tasks declared by `StaticTask_t` in order before `Scheduler::launch`, without `palloc` or yield.
+	// Only checks them against the tasks that `launch` creates, not any dynamic one.
+	template <typename... Tasks>
+	inline void
+	boot(Tasks&... tasks)
+	{
+		// Idles on each core, and the log task on core 0 if any
+		constexpr uint32_t RESERVED = CORE_NUM + ((MOS_CONF_PRINTF && MOS_CONF_LOG_ASYNC) ? 1 : 0);
+		static_assert(sizeof...(Tasks) + RESERVED <= TASK_MAX, "Too many tasks besides the kernel ones");
+
+		IrqGuard_t guard;
+		const bool ok = (... && (tasks.build() != nullptr));
+		MOS_ASSERT(ok, "Static Task Failed");
+	}
+
 	static inline void
 	block_to_raw(
 	    TcbPtr_t tcb,
@@ -322,7 +480,7 @@ namespace MOS::Kernel::Task
 	)
 	{
 		tcb->set_status(BLOCKED);
-		ready_list.send_to(tcb, dest);
+		ready_of(tcb).send_to(tcb, dest);
 	}
 
 	static inline void
@@ -333,7 +491,7 @@ namespace MOS::Kernel::Task
 	)
 	{
 		tcb->set_status(BLOCKED);
-		ready_list.send_to_in_order(tcb, dest, cmp);
+		ready_of(tcb).send_to_in_order(tcb, dest, cmp);
 	}
 
 	inline void
@@ -344,9 +502,7 @@ namespace MOS::Kernel::Task
 		if (tcb == nullptr || tcb->is_status(BLOCKED))
 			return;
 		block_to_raw(tcb, dest);
-		if (tcb == current()) {
-			return yield();
-		}
+		return reschedule(tcb);
 	}
 
 	inline void
@@ -361,9 +517,7 @@ namespace MOS::Kernel::Task
 		if (tcb == nullptr || tcb->is_status(BLOCKED))
 			return;
 		block_to_in_order_raw(tcb, dest, cmp);
-		if (tcb == current()) {
-			return yield();
-		}
+		return reschedule(tcb);
 	}
 
 	MOS_INLINE inline void
@@ -379,7 +533,8 @@ namespace MOS::Kernel::Task
 	)
 	{
 		tcb->set_status(READY);
-		src.send_to_in_order(tcb, ready_list, TCB_t::pri_cmp);
+		src.remove(tcb);
+		ready_raw(tcb);
 	}
 
 	inline void
@@ -411,41 +566,55 @@ namespace MOS::Kernel::Task
 		resume_raw(tcb, src);
 	}
 
+	// Apply `update` on the priority of `tcb` and keep ready_list indexed
+	static inline void
+	change_pri_raw(TcbPtr_t tcb, auto&& update)
+	{
+		const bool queued = tcb->is_status(READY) ||
+		                    tcb->is_status(RUNNING);
+		if (queued) ready_of(tcb).remove(tcb);
+		update(tcb);
+		if (queued) ready_of(tcb).add(tcb);
+	}
+
 	inline void
 	change_pri(TcbPtr_t tcb, Prior_t pri)
 	{
 		MOS_ASSERT(test_irq(), "Disabled Interrupt");
 		IrqGuard_t guard;
-		tcb->set_pri(pri);
-		ready_list.re_insert(tcb, TCB_t::pri_cmp);
+		change_pri_raw(tcb, [pri](TcbPtr_t tcb) {
+			tcb->set_pri(pri);
+		});
 		if (any_higher()) {
 			return yield();
 		}
 	}
 
+	// Find by `Tid_t` in O(1), or by `Name_t` through the name hash
 	inline TcbPtr_t
 	find(auto info)
 	{
 		IrqGuard_t guard;
+		return tasks.find(info);
+	}
 
-		auto fetch = [info](TcbPtr_t tcb) {
-			if constexpr (Same<decltype(info), Tid_t>) {
-				return tcb->get_tid() == info;
-			}
-
-			if constexpr (Same<decltype(info), Name_t>) {
-				return strcmp(tcb->get_name(), info) == 0;
-			}
-		};
-
-		return debug_tcbs.iter_until(fetch);
+	// Find by a name hashed in advance, e.g. `Tasks_t::hash("wdog")` at compile time
+	inline TcbPtr_t
+	find(Name_t name, Tasks_t::Hash_t code)
+	{
+		IrqGuard_t guard;
+		return tasks.find(name, code);
 	}
 
 	MOS_INLINE inline void
 	print_name()
 	{
-		IrqGuard_t guard;
-		kprintf("%s\n", current()->get_name());
+		Name_t name;
+		{
+			IrqGuard_t guard;
+			name = current()->get_name();
+		}
+		kprintf("%s\n", name);
 	}
 
 	MOS_INLINE inline constexpr auto
@@ -460,43 +629,115 @@ namespace MOS::Kernel::Task
 		}
 	};
 
-	inline void
-	print_info(
-	    TcbPtr_t tcb,
-	    const char* format = " #%-3d %-12s %-5d %-9s %3d%%\n"
-	)
+	// What `print_info` shows, copied under the guard to be formatted after it
+	struct Info_t
 	{
-		kprintf(
-		    format,
+		Tid_t tid;
+		Name_t name;
+		Prior_t pri;
+		TCB_t::Status status;
+		uint32_t usage;
+#if (MOS_CONF_STACK_PAINT == true)
+		uint32_t peak, size; // Bytes of stack
+#endif
+	};
+
+#if (MOS_CONF_STACK_PAINT == true)
+	constexpr const char* INFO_FORMAT = " #%-3d %-12s %-5d %-9s %3d%% %5u/%-5u\n"; // Along with peak/total bytes of stack
+#else
+	constexpr const char* INFO_FORMAT = " #%-3d %-12s %-5d %-9s %3d%%\n";
+#endif
+
+	MOS_INLINE inline Info_t
+	info_of(TcbPtr_t tcb)
+	{
+		return {
 		    tcb->get_tid(),
 		    tcb->get_name(),
 		    tcb->get_pri(),
-		    status_name(tcb->get_status()),
-		    tcb->stack_usage()
+		    tcb->get_status(),
+		    tcb->stack_usage(),
+#if (MOS_CONF_STACK_PAINT == true)
+		    tcb->stack_peak(),
+		    tcb->stack_size(),
+#endif
+		};
+	}
+
+	inline void
+	print_info(const Info_t& info, const char* format = INFO_FORMAT)
+	{
+		kprintf(
+		    format,
+		    info.tid,
+		    info.name,
+		    info.pri,
+		    status_name(info.status),
+#if (MOS_CONF_STACK_PAINT == true)
+		    info.usage,
+		    info.peak,
+		    info.size
+#else
+		    info.usage
+#endif
 		);
-	};
+	}
+
+	inline void
+	print_info(TcbPtr_t tcb, const char* format = INFO_FORMAT)
+	{
+		Info_t info;
+		{
+			IrqGuard_t guard;
+			info = info_of(tcb);
+		}
+		print_info(info, format);
+	}
 
 	// For debug only
 	inline void print_all()
 	{
-		IrqGuard_t guard;
+		// Kept off the caller stack, e.g. of the shell, so a caller at a time
+		static Info_t infos[TASK_MAX];
+		uint32_t cnt = 0;
+		{
+			IrqGuard_t guard;
+			debug_tcbs.iter([&](TcbPtr_t tcb) {
+				if (cnt < TASK_MAX) infos[cnt++] = info_of(tcb);
+			});
+		}
+
 		kprintf("----------------------------------------\n");
-		debug_tcbs.iter([](TcbPtr_t tcb) { print_info(tcb); });
+		for (uint32_t i = 0; i < cnt; i++) {
+			print_info(infos[i]);
+		}
 		kprintf("----------------------------------------\n");
 	}
 
+	static inline void
+	sleep_raw(TcbPtr_t tcb, const Tick_t ticks)
+	{
+		tcb->set_status(BLOCKED);
+		tcb->set_wkpt(os_ticks + ticks);
+		ready_of(tcb).remove(tcb);
+		sleeping_list.add(tcb); // O(1) insertion into the timer wheel
+	}
+
 	void delay(const Tick_t ticks)
 	{
-		auto cur = current();
-		cur->set_wkpt(os_ticks + ticks);
-		block_to_in_order(cur, sleeping_list, TCB_t::wkpt_cmp);
+		MOS_ASSERT(test_irq(), "Disabled Interrupt");
+		IrqGuard_t guard;
+		sleep_raw(current(), ticks);
+		return yield();
 	}
 
 	inline void
 	wake_raw(TcbPtr_t tcb)
 	{
-		tcb->set_wkpt(0xFFFF'FFFF); // Set wakepoint as invalid
-		Task::resume_raw(tcb, sleeping_list);
+		tcb->set_status(READY);
+		sleeping_list.remove(tcb);      // Remove before the wakepoint changes
+		tcb->set_wkpt(TCB_t::WKPT_INV); // Set wakepoint as invalid
+		ready_raw(tcb);
 	}
 }
 
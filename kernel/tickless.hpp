@@ -0,0 +1,87 @@
+#ifndef _MOS_TICKLESS_
+#define _MOS_TICKLESS_
+
+#include "task.hpp"
+
+namespace MOS::Kernel::Tickless
+{
+	using namespace Global;
+	using Utils::IrqGuard_t;
+
+	using Tick_t = TCB_t::Tick_t;
+
+	// Suppressing less than 2 ticks gains nothing, since the last one is always counted by SysTick
+	constexpr Tick_t MIN_IDLE = 2;
+
+	// Ticks until the earliest sleeper should wake up, at most `limit`
+	MOS_INLINE inline Tick_t
+	expected_idle(const Tick_t limit)
+	{
+		if (sleeping_list.empty()) {
+			return limit;
+		}
+		return sleeping_list.earliest(os_ticks, limit);
+	}
+
+	// Used in idle task, stop ticking until the next wakeup or any other interrupt
+	inline void sleep()
+	{
+		const uint32_t cycles   = MOS_SYSTICK_CYCLES(), // Cycles per tick
+		               max_idle = MOS_SYSTICK_MAX_LOAD / cycles;
+
+		// `WFI` still wakes up on a pending interrupt while PRIMASK is set
+		IrqGuard_t guard;
+
+		// Only the first core counts ticks, and someone else is ready to run
+		if (core_id() != 0 ||
+		    ready_on(0).size() > 1 ||
+		    !zombie_list.empty()) {
+			return;
+		}
+
+		const auto idle = expected_idle(max_idle);
+		if (idle < MIN_IDLE) return;
+
+		MOS_SYSTICK_STOP();
+
+		// A tick is already pending, abort and let SysTick handle it
+		if (MOS_SYSTICK_PENDING()) {
+			MOS_SYSTICK_START();
+			return;
+		}
+
+		// The current tick is partly elapsed, append `idle - 1` full ticks to it
+		const uint32_t reload = MOS_SYSTICK_GET_VAL() + cycles * (idle - 1);
+		MOS_SYSTICK_SET_LOAD(reload);
+		MOS_SYSTICK_CLR_VAL();
+		MOS_SYSTICK_START();
+
+		MOS_DSB();
+		MOS_WFI();
+		MOS_ISB();
+
+		MOS_SYSTICK_STOP();
+
+		Tick_t elapsed;
+		if (MOS_SYSTICK_COUNTED()) {
+			// Whole period slept, the last tick will be counted by the pending SysTick
+			const uint32_t rest = (cycles - 1) - (reload - MOS_SYSTICK_GET_VAL());
+			MOS_SYSTICK_SET_LOAD((rest < cycles) ? rest : cycles - 1);
+			elapsed = idle - 1;
+		}
+		else { // Woken up early by another interrupt
+			const uint32_t passed = cycles * idle - MOS_SYSTICK_GET_VAL();
+			elapsed               = passed / cycles;
+			MOS_SYSTICK_SET_LOAD((elapsed + 1) * cycles - passed);
+		}
+
+		os_ticks += elapsed; // Correct the missing ticks
+
+		// Restart from the rest of current tick, then back to period
+		MOS_SYSTICK_CLR_VAL();
+		MOS_SYSTICK_START();
+		MOS_SYSTICK_SET_LOAD(cycles - 1);
+	}
+}
+
+#endif
\ No newline at end of file
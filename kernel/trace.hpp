@@ -0,0 +1,223 @@
+#ifndef _MOS_TRACE_
+#define _MOS_TRACE_
+
+#include "task.hpp"
+#include "data_type/ring.hpp"
+
+namespace MOS::Kernel::Trace
+{
+	using namespace Global;
+	using Utils::IrqGuard_t;
+
+	using Cycle_t = uint32_t;
+	using Tid_t   = TCB_t::Tid_t;
+
+	// Why the previous task is switched out
+	enum class Reason_t : uint8_t
+	{
+		Preempt, // A task with higher priority is ready
+		Slice,   // Time slice exhausted, rotated among the same priority
+		Block,   // Blocked or sleeping
+		Exit,    // Terminated
+	};
+
+	using enum Reason_t;
+
+	struct Record_t
+	{
+		Cycle_t stamp;   // Cycle counter of the core on switching
+		Tid_t from, to;  // Tids of the previous and the next task
+		Core_t core;     // Core that switches
+		Reason_t reason; // Why `from` is switched out
+	};
+
+	// Leading a binary dump, followed by records from the oldest one
+	struct Header_t
+	{
+		uint32_t magic;  // "MOST" in little endian
+		uint16_t size;   // Bytes of a record
+		uint16_t cap;    // Records retained at most
+		uint32_t total;  // Records ever traced, wraps around
+		uint32_t freq;   // Cycles per second
+	};
+
+	using Ring_t = DataType::SeqRing_t<Record_t, TRACE_SIZE>;
+
+	// Only written in `next_tcb` under the kernel lock
+	Ring_t ring;
+
+	// Cycles when the running task is last charged, one per core
+	Cycle_t charged[CORE_NUM];
+
+	// Earliest `irq_mark` not yet followed by a switch, one per core
+	Cycle_t marked[CORE_NUM];
+	bool is_marked[CORE_NUM];
+
+	// Worst cycles from `irq_mark` to the next context switch
+	MOS_DEBUG_INFO static Cycle_t max_latency = 0;
+
+	// Each core starts charging once before scheduling, after its cycle counter is enabled
+	MOS_INLINE inline void
+	init() { charged[core_id()] = MOS_CYCLES(); }
+
+	// Called at the beginning of an ISR that wakes up a task,
+	// the latency till the context switch it leads to is measured.
+	MOS_INLINE inline void
+	irq_mark()
+	{
+		IrqGuard_t guard;
+		const auto core = core_id();
+		if (!is_marked[core]) {
+			marked[core]    = MOS_CYCLES();
+			is_marked[core] = true;
+		}
+	}
+
+	// Charge the running task on this core up to now, IRQs disabled
+	MOS_INLINE inline Cycle_t
+	charge_raw()
+	{
+		const auto core   = core_id();
+		const Cycle_t now = MOS_CYCLES();
+		Task::current()->cycles += now - charged[core];
+		charged[core] = now;
+		return now;
+	}
+
+	MOS_INLINE inline Reason_t
+	reason_of(TcbPtr_t prev, TcbPtr_t next)
+	{
+		if (prev->is_status(TCB_t::TERMINATED)) return Exit;
+		if (prev->is_status(TCB_t::BLOCKED)) return Block;
+		return TCB_t::pri_cmp(next, prev) ? Preempt : Slice;
+	}
+
+	// Called in `next_tcb` after selecting, `prev` is charged but `cur_tcb` is already the next one
+	inline void
+	on_switch(TcbPtr_t prev, Cycle_t now)
+	{
+		const auto core = core_id();
+		const auto next = Task::current();
+
+		if (next == prev) return;
+
+		const auto reason = reason_of(prev, next);
+		if (reason == Preempt || reason == Slice) {
+			prev->preempts += 1;
+		}
+		next->switches += 1;
+
+		ring.push({now, prev->get_tid(), next->get_tid(), core, reason});
+
+		if (is_marked[core]) {
+			const Cycle_t latency = now - marked[core];
+			if (latency > max_latency) {
+				max_latency = latency;
+			}
+			is_marked[core] = false;
+		}
+	}
+
+	// Copy the latest `n` records at most in order, return the number copied
+	MOS_INLINE inline uint32_t
+	latest(Record_t* dest, uint32_t n)
+	{
+		uint32_t pos = ring.total() - n;
+		return ring.read(pos, dest, n);
+	}
+
+	// Write the header and all retained records through `write(data, bytes)`, the ring keeps recording meanwhile
+	inline void
+	dump(auto&& write)
+	{
+		const Header_t header {
+		    .magic = 0x5453'4F4D,
+		    .size  = sizeof(Record_t),
+		    .cap   = Ring_t::capacity(),
+		    .total = ring.total(),
+		    .freq  = MOS_CYCLES_FREQ(),
+		};
+
+		write((const void*) &header, sizeof(header));
+
+		Record_t buf[8];
+		uint32_t pos = header.total - ring.size();
+
+		// Stop at `header.total`, or once `pos` is pushed beyond it by overwriting
+		for (uint32_t left; (left = header.total - pos) != 0 && left <= TRACE_SIZE;) {
+			const auto n = ring.read(pos, buf, left < 8 ? left : 8);
+			write((const void*) buf, n * sizeof(Record_t));
+		}
+	}
+
+	// Clear all counters and the worst latency, the trace ring is kept
+	inline void
+	reset()
+	{
+		IrqGuard_t guard;
+		charge_raw();
+		debug_tcbs.iter([](TcbPtr_t tcb) {
+			tcb->cycles   = 0;
+			tcb->switches = 0;
+			tcb->preempts = 0;
+		});
+		max_latency = 0;
+	}
+
+	// CPU usage of each task since boot or the last `reset`
+	inline void
+	print_top()
+	{
+		struct Row_t
+		{
+			Tid_t tid;
+			TCB_t::Name_t name;
+			TCB_t::Prior_t pri;
+			uint64_t cycles;
+			uint32_t switches, preempts;
+		};
+
+		// Copied under the guard and printed after it, so that printing never blocks IRQs.
+		// Kept off the caller stack, e.g. of the shell, so a caller at a time.
+		static Row_t rows[TASK_MAX];
+		uint32_t cnt = 0, total, latency;
+		uint64_t sum = 0;
+		{
+			IrqGuard_t guard;
+			charge_raw();
+			debug_tcbs.iter([&](TcbPtr_t tcb) {
+				if (cnt == TASK_MAX) return;
+				rows[cnt++] = {
+				    tcb->get_tid(),
+				    tcb->get_name(),
+				    tcb->get_pri(),
+				    tcb->cycles,
+				    tcb->switches,
+				    tcb->preempts,
+				};
+				sum += tcb->cycles;
+			});
+			total   = ring.total();
+			latency = max_latency;
+		}
+		if (sum == 0) sum = 1;
+
+		kprintf(" %-4s %-12s %-5s %6s %8s %8s\n", "tid", "name", "pri", "cpu", "switch", "preempt");
+		for (uint32_t i = 0; i < cnt; i++) {
+			const auto& row     = rows[i];
+			const auto permille = (uint32_t) (row.cycles * 1000 / sum);
+			kprintf(
+			    " #%-3d %-12s %-5d %3u.%u%% %8u %8u\n",
+			    row.tid,
+			    row.name,
+			    row.pri,
+			    permille / 10, permille % 10,
+			    row.switches,
+			    row.preempts
+			);
+		}
+		kprintf(" traced: %u, worst irq->switch: %u cycles\n", total, latency);
+	}
+}
+
+#endif
\ No newline at end of file
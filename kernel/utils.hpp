@@ -20,7 +20,18 @@
 #if (MOS_CONF_PRINTF == true)
 #include "printf.h"
 #define MOS_PUTCHAR       _putchar
+
+#if (MOS_CONF_LOG_ASYNC == true)
+namespace MOS::Kernel::Log
+{
+	// Defined in "log.hpp"
+	inline int printf(const char* format, ...);
+	inline void panic();
+}
+#define kprintf(fmt, ...) MOS::Kernel::Log::printf(fmt, ##__VA_ARGS__)
+#else
 #define kprintf(fmt, ...) printf_(fmt, ##__VA_ARGS__)
+#endif
 
 #if (MOS_CONF_LOG_TIME == true)
 extern "C" volatile uint32_t os_ticks;
@@ -39,6 +50,24 @@ extern "C" volatile uint32_t os_ticks;
 #define LOG(fmt, ...)     ((void) 0)
 #endif
 
+#if (MOS_CONF_LOG_BINARY == true)
+// Deferred `LOG` for hot paths, formatted later by `BinLog::print` or on host, see "bin_log.hpp".
+// Format strings stay in sections `.mos_log.*`, which can be left out of flash if only dumped to host.
+// One section per call, as a call in an inline function or a template can't share it with a plain one.
+#define MOS_LOG_STR(x)     #x
+#define MOS_LOG_SECTION(n) ".mos_log." MOS_LOG_STR(n)
+#define BLOG(fmt, ...)     MOS_BLOG_AT(__COUNTER__, fmt, ##__VA_ARGS__)
+#define MOS_BLOG_AT(n, fmt, ...)                                                               \
+	do {                                                                                       \
+		using __Types = decltype(MOS::Kernel::BinLog::types(__VA_ARGS__));                     \
+		__attribute__((section(MOS_LOG_SECTION(n)), used)) static const char __fmt[] = fmt;    \
+		static constexpr MOS::Kernel::BinLog::Site_t __site = __Types::site(__fmt);            \
+		MOS::Kernel::BinLog::write(&__site, ##__VA_ARGS__);                                    \
+	} while (0)
+#else
+#define BLOG(fmt, ...) LOG(fmt, ##__VA_ARGS__)
+#endif
+
 #if (MOS_CONF_ASSERT == true)
 #define MOS_ASSERT(expr, fmt, ...) \
 	((expr) ? ((void) 0) : mos_assert_failed((uint8_t*) __FILE__, __LINE__, (uint8_t*) __func__, fmt))
@@ -47,6 +76,9 @@ static inline void
 mos_assert_failed(void* file, uint32_t line, void* func, const char* msg)
 {
 	LOG("%s(%d) <%s>: \"%s\"", file, line, func, msg);
+#if (MOS_CONF_PRINTF == true) && (MOS_CONF_LOG_ASYNC == true)
+	MOS::Kernel::Log::panic(); // The log task may never run again
+#endif
 	while (true) {
 		MOS_NOP();
 	}
@@ -187,31 +219,267 @@ namespace MOS::Utils
 		rend() const { return {st - n, -n}; }
 	};
 
+	// Busy-waiting lock between cores, hold it only with IRQs disabled
+	struct SpinLock_t
+	{
+		MOS_INLINE inline void
+		lock() volatile
+		{
+			while (!MOS_SPIN_TRY_LOCK(&flag)) {
+				MOS_NOP();
+			}
+			MOS_DMB();
+		}
+
+		MOS_INLINE inline void
+		unlock() volatile
+		{
+			MOS_DMB();
+			flag = 0;
+		}
+
+	private:
+		volatile uint32_t flag = 0;
+	};
+
+#if (MOS_CONF_IRQ_PROF == true)
+	// Cycles of outermost critical sections collected per call site of `IrqGuard_t`.
+	// Each section is stamped right after IRQs are disabled and right before enabled,
+	// then recorded still with IRQs disabled, so the lookup itself is not counted.
+	struct IrqSite_t
+	{
+		// Bucket `i` counts sections below `16 << 2i` cycles, and the last one for all longer
+		static constexpr uint32_t BUCKETS = 8;
+
+		const char* file       = nullptr;
+		uint32_t line          = 0,
+		         cnt           = 0,
+		         max           = 0; // Cycles
+		uint32_t hist[BUCKETS] = {0};
+	};
+
+	struct IrqProf_t
+	{
+		using Site_t  = IrqSite_t;
+		using Cycle_t = uint32_t;
+		using File_t  = const char*;
+		using Line_t  = uint32_t;
+
+		static constexpr uint32_t BUCKETS = Site_t::BUCKETS;
+		static constexpr uint32_t SITES   = MOS_CONF_IRQ_PROF_SITES;
+
+		static_assert(SITES != 0 && (SITES & (SITES - 1)) == 0, "Size must be power of 2");
+
+		MOS_INLINE static inline void
+		begin(File_t file, Line_t line)
+		{
+			auto& sec = open[MOS_CORE_ID()];
+			sec.file  = file;
+			sec.line  = line;
+			sec.start = MOS_CYCLES();
+		}
+
+		MOS_INLINE static inline void
+		end()
+		{
+			const Cycle_t now = MOS_CYCLES();
+			const auto& sec   = open[MOS_CORE_ID()];
+			record(sec.file, sec.line, now - sec.start);
+		}
+
+		// Copy the `idx`-th slot, return false if unused
+		static inline bool
+		get(uint32_t idx, Site_t& dest);
+
+		static inline void
+		reset();
+
+		static inline void
+		print();
+
+	private:
+		struct Open_t
+		{
+			File_t file;
+			Line_t line;
+			Cycle_t start;
+		};
+
+		static inline Open_t open[MOS_CONF_CORE_NUM];
+		static inline Site_t sites[SITES];
+		static inline uint32_t dropped = 0; // Sections of sites beyond `SITES`
+
+		MOS_INLINE static inline uint32_t
+		bucket_of(Cycle_t cycles)
+		{
+			uint32_t i = 0;
+			for (cycles >>= 4; cycles != 0 && i < BUCKETS - 1; cycles >>= 2) {
+				i += 1;
+			}
+			return i;
+		}
+
+		// Open addressing by file and line, a new site takes the first free slot
+		static inline Site_t*
+		find(File_t file, Line_t line)
+		{
+			auto idx = ((uint32_t) (uintptr_t) file ^ (line * 0x9E37'79B1U)) & (SITES - 1);
+			for (uint32_t i = 0; i < SITES; i++, idx = (idx + 1) & (SITES - 1)) {
+				auto& site = sites[idx];
+				if (site.file == file && site.line == line) {
+					return &site;
+				}
+				if (site.file == nullptr) {
+					site.file = file;
+					site.line = line;
+					return &site;
+				}
+			}
+			return nullptr;
+		}
+
+		static inline void
+		record(File_t file, Line_t line, Cycle_t cycles)
+		{
+			const auto site = find(file, line);
+			if (site == nullptr) {
+				dropped += 1;
+				return;
+			}
+			site->cnt += 1;
+			site->hist[bucket_of(cycles)] += 1;
+			if (cycles > site->max) {
+				site->max = cycles;
+			}
+		}
+	};
+#endif
+
 	// Enter/Exit Global Critical Section
+	// With multiple cores, the outermost guard of each core also holds the kernel lock.
+	// With `MOS_CONF_IRQ_PROF`, the outermost guard is profiled by the call site as default.
 	struct IrqGuard_t
 	{
 		using NestCnt_t = volatile Atomic_t<int32_t>;
+		using File_t    = const char*;
+		using Line_t    = uint32_t;
 
 		MOS_INLINE
-		inline IrqGuard_t()
+		inline IrqGuard_t(
+		    File_t file = __builtin_FILE(),
+		    Line_t line = __builtin_LINE()
+		)
 		{
 			MOS_DISABLE_IRQ();
-			cnt += 1;
+			enter(file, line);
 		}
 
 		MOS_INLINE
 		inline ~IrqGuard_t()
 		{
-			cnt -= 1;
-			if (cnt <= 0) {
+			if (leave()) {
 				MOS_ENABLE_IRQ();
 			}
 		}
 
+		// Nest without touching PRIMASK, for handlers running with IRQs disabled
+		MOS_INLINE static inline void
+		enter(
+		    [[maybe_unused]] File_t file = __builtin_FILE(),
+		    [[maybe_unused]] Line_t line = __builtin_LINE()
+		)
+		{
+			auto& nest = cnt[MOS_CORE_ID()];
+			if (nest <= 0) {
+#if (MOS_CONF_IRQ_PROF == true)
+				IrqProf_t::begin(file, line); // Spinning for the kernel lock counts
+#endif
+#if (MOS_CONF_CORE_NUM > 1)
+				kernel_lock.lock();
+#endif
+			}
+			nest += 1;
+		}
+
+		// Return true if it's the outermost one
+		MOS_INLINE static inline bool
+		leave()
+		{
+			auto& nest = cnt[MOS_CORE_ID()];
+			nest -= 1;
+			if (nest <= 0) {
+#if (MOS_CONF_IRQ_PROF == true)
+				IrqProf_t::end();
+#endif
+#if (MOS_CONF_CORE_NUM > 1)
+				kernel_lock.unlock();
+#endif
+				return true;
+			}
+			return false;
+		}
+
 	private:
-		static inline NestCnt_t cnt = 0;
+		static inline NestCnt_t cnt[MOS_CONF_CORE_NUM] = {0};
+
+#if (MOS_CONF_CORE_NUM > 1)
+		static inline SpinLock_t kernel_lock;
+#endif
 	};
 
+#if (MOS_CONF_IRQ_PROF == true)
+	inline bool
+	IrqProf_t::get(uint32_t idx, Site_t& dest)
+	{
+		IrqGuard_t guard;
+		dest = sites[idx];
+		return dest.file != nullptr;
+	}
+
+	inline void
+	IrqProf_t::reset()
+	{
+		IrqGuard_t guard;
+		for (auto& site: sites) {
+			site = Site_t {};
+		}
+		dropped = 0;
+	}
+
+	// Each site is copied in a short critical section, then printed with IRQs enabled
+	inline void
+	IrqProf_t::print()
+	{
+		auto base = [](File_t file) {
+			auto name = file;
+			for (; *file; file++) {
+				if (*file == '/' || *file == '\\') name = file + 1;
+			}
+			return name;
+		};
+
+		kprintf(" %-20s %6s %7s", "site", "count", "max");
+		for (uint32_t i = 0; i < BUCKETS - 1; i++) {
+			kprintf(" <%-5u", 16U << (2 * i));
+		}
+		kprintf(" %-6s\n", "more");
+
+		Site_t site;
+		for (uint32_t idx = 0; idx < SITES; idx++) {
+			if (!get(idx, site)) continue;
+			kprintf(" %15s:%-4u %6u %7u", base(site.file), site.line, site.cnt, site.max);
+			for (auto n: site.hist) {
+				kprintf(" %6u", n);
+			}
+			kprintf("\n");
+		}
+
+		if (dropped != 0) {
+			kprintf(" %u sections of untracked sites\n", dropped);
+		}
+	}
+#endif
+
 	template <typename T>
 	inline constexpr T&&
 	move(T& x) noexcept
@@ -242,4 +510,12 @@ operator""_s(uint64_t raw) noexcept
 // MOS_INLINE inline void*
 // operator new(size_t, void* addr) noexcept { return addr; }
 
+#if (MOS_CONF_PRINTF == true) && (MOS_CONF_LOG_ASYNC == true)
+#include "log.hpp"
+#endif
+
+#if (MOS_CONF_LOG_BINARY == true)
+#include "bin_log.hpp"
+#endif
+
 #endif
\ No newline at end of file
@@ -11,6 +11,14 @@
 #include "kernel/task.hpp"
 #include "kernel/data_type/buffer.hpp"
 
+#if (MOS_CONF_TRACE == true)
+#include "kernel/trace.hpp"
+#endif
+
+#if (MOS_CONF_BENCH == true)
+#include "kernel/bench.hpp"
+#endif
+
 namespace MOS::Shell
 {
 	using namespace Kernel;
@@ -140,6 +148,52 @@ namespace MOS::Shell
 			);
 		}
 
+		static inline void
+		mem_cmd(Argv_t _)
+		{
+			Alloc::print_pools();
+			Alloc::print_heap();
+#if (MOS_CONF_ASYNC_USE_POOL == true)
+			Async::PromiseAllocator::print_stats();
+#endif
+		}
+
+#if (MOS_CONF_TRACE == true)
+		static inline void
+		top_cmd(Argv_t argv)
+		{
+			if (strcmp(argv, "-c") == 0) {
+				Trace::reset();
+				LOG("Trace counters cleared");
+				return;
+			}
+			Trace::print_top();
+		}
+#endif
+
+#if (MOS_CONF_IRQ_PROF == true)
+		static inline void
+		irq_cmd(Argv_t argv)
+		{
+			if (strcmp(argv, "-c") == 0) {
+				IrqProf_t::reset();
+				LOG("IRQ profile cleared");
+				return;
+			}
+			IrqProf_t::print();
+		}
+#endif
+
+#if (MOS_CONF_BENCH == true)
+		static inline void
+		bench_cmd(Argv_t _) { Bench::run(); }
+#endif
+
+#if (MOS_CONF_LOG_BINARY == true)
+		static inline void
+		blog_cmd(Argv_t _) { BinLog::print(); }
+#endif
+
 		static inline void
 		uname_cmd(Argv_t argv)
 		{
@@ -179,6 +233,19 @@ namespace MOS::Shell
 		    {"resume", resume_cmd}, // Resume a task
 		    {  "help",   help_cmd}, // Show help info
 		    {  "time",   time_cmd}, // Show system uptime
+		    {   "mem",    mem_cmd}, // Show page pool and heap statistics
+#if (MOS_CONF_TRACE == true)
+		    {   "top",    top_cmd}, // Show CPU usage of tasks, `-c` to clear
+#endif
+#if (MOS_CONF_IRQ_PROF == true)
+		    {   "irq",    irq_cmd}, // Show cycles of critical sections per site, `-c` to clear
+#endif
+#if (MOS_CONF_BENCH == true)
+		    { "bench",  bench_cmd}, // Run microbenchmarks, print CSV rows in cycles
+#endif
+#if (MOS_CONF_LOG_BINARY == true)
+		    {  "blog",   blog_cmd}, // Format and flush binary log records
+#endif
 		    { "uname",  uname_cmd}, // Show system info / Set user name
 		    {"reboot", reboot_cmd}, // Reboot system
 